@@ -16,10 +16,10 @@
 #include <list>
 #include <ostream>
 #include <stack>
-#include <typeinfo>
 #include <vector>
 
 #include "cpp_utils/util.h"
+#include "utils/type_name.h"
 
 template <typename T>
 class Stack {
@@ -236,7 +236,7 @@ template <typename T, typename Container=std::vector<T>>
 class Queue {
 public:
   void print_container_type() {
-    std::println("{}", typeid(elems).name());
+    std::println("{}", utils::type_name<Container>());
   }
 private:
   Container elems;
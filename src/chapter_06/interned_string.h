@@ -0,0 +1,222 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 11:20:05
+# Desc   : 字符串驻留(string interning), 为 Person 提供 4 字节的 name
+########################################################################
+*/
+/*
+1. StringInterner: 全局字符串池
+  a. 字符串只保存一份，存放在按块分配的 arena 中，地址稳定，永不释放
+  b. 通过分片(shard)的哈希表去重, 每个分片一把 std::shared_mutex, 查找只加读锁
+  c. id -> std::string_view 使用分段数组, 查找不加锁
+  d. 每个线程有一个小缓存，命中时不需要访问分片
+2. InternedString: 只有一个 uint32_t id, 比较和哈希都是 O(1)
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class StringInterner {
+public:
+  using Id = std::uint32_t;
+
+  static StringInterner& instance() {
+    static StringInterner interner;
+    return interner;
+  }
+
+  Id intern(std::string_view s) {
+    auto hash = std::hash<std::string_view>{}(s);
+    // 每个线程一个小的直接映射缓存, 重复的名字不需要加锁
+    thread_local std::array<CacheEntry, kCacheSize> cache{};
+    CacheEntry& cached = cache[(hash / kShardCount) % kCacheSize];
+    if (cached.stored.data() != nullptr && cached.hash == hash && cached.stored == s) {
+      return cached.id;
+    }
+    Id id = intern_slow(s, hash);
+    cached = {hash, view(id), id};
+    return id;
+  }
+
+  std::string_view view(Id id) const {
+    const Entry* block = blocks_[id / kBlockSize].load(std::memory_order_acquire);
+    assert(block != nullptr);
+    return {block[id % kBlockSize].data, block[id % kBlockSize].size};
+  }
+
+  std::size_t size() const { return next_id_.load(std::memory_order_relaxed); }
+
+  // arena 和索引占用的字节数, 用于和 std::string 比较内存
+  std::size_t memory_usage() const {
+    std::size_t bytes = 0;
+    for (const auto& shard : shards_) {
+      std::shared_lock lock(shard.mutex);
+      bytes += shard.chunks.size() * kChunkSize + shard.large_bytes;
+      // unordered_map 节点: key + value + next 指针, 再加上桶数组
+      bytes += shard.ids.size() * (sizeof(std::string_view) + sizeof(Id) + sizeof(void*));
+      bytes += shard.ids.bucket_count() * sizeof(void*);
+    }
+    for (const auto& block : blocks_) {
+      if (block.load(std::memory_order_relaxed) != nullptr) {
+        bytes += kBlockSize * sizeof(Entry);
+      }
+    }
+    return bytes;
+  }
+
+  StringInterner(const StringInterner&) = delete;
+  StringInterner& operator=(const StringInterner&) = delete;
+  ~StringInterner() {
+    for (auto& block : blocks_) {
+      delete[] block.load(std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static constexpr std::size_t kShardCount = 64;
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+  static constexpr std::size_t kBlockSize = 64 * 1024;
+  static constexpr std::size_t kMaxBlocks = (std::size_t{1} << 32) / kBlockSize;
+  static constexpr std::size_t kCacheSize = 1024;
+
+  struct Entry {
+    const char* data;
+    std::size_t size;
+  };  // struct Entry
+
+  struct CacheEntry {
+    std::size_t hash{0};
+    std::string_view stored;
+    Id id{0};
+  };  // struct CacheEntry
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string_view, Id> ids;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::size_t used{kChunkSize};
+    std::vector<std::unique_ptr<char[]>> large;  // 超长字符串单独分配
+    std::size_t large_bytes{0};
+
+    // 调用者持有写锁
+    std::string_view store(std::string_view s) {
+      if (s.empty()) {
+        return {};
+      }
+      if (s.size() > kChunkSize / 4) {
+        large.emplace_back(new char[s.size()]);
+        large_bytes += s.size();
+        std::memcpy(large.back().get(), s.data(), s.size());
+        return {large.back().get(), s.size()};
+      }
+      if (kChunkSize - used < s.size()) {
+        chunks.emplace_back(new char[kChunkSize]);
+        used = 0;
+      }
+      char* dst = chunks.back().get() + used;
+      std::memcpy(dst, s.data(), s.size());
+      used += s.size();
+      return {dst, s.size()};
+    }
+  };  // struct Shard
+
+  StringInterner() = default;
+
+  Id intern_slow(std::string_view s, std::size_t hash) {
+    Shard& shard = shards_[hash % kShardCount];
+    {
+      std::shared_lock lock(shard.mutex);
+      if (auto it = shard.ids.find(s); it != shard.ids.end()) {
+        return it->second;
+      }
+    }
+    std::unique_lock lock(shard.mutex);
+    // 加写锁之前可能已经有其他线程插入了
+    if (auto it = shard.ids.find(s); it != shard.ids.end()) {
+      return it->second;
+    }
+    std::string_view stored = shard.store(s);
+    Id id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    set_view(id, stored);
+    shard.ids.emplace(stored, id);
+    return id;
+  }
+
+  void set_view(Id id, std::string_view s) {
+    auto& slot = blocks_[id / kBlockSize];
+    Entry* block = slot.load(std::memory_order_acquire);
+    if (block == nullptr) {
+      auto* fresh = new Entry[kBlockSize]{};
+      if (slot.compare_exchange_strong(block, fresh, std::memory_order_acq_rel)) {
+        block = fresh;
+      } else {
+        delete[] fresh;
+      }
+    }
+    block[id % kBlockSize] = {s.data(), s.size()};
+  }
+
+  std::array<Shard, kShardCount> shards_;
+  std::atomic<Id> next_id_{0};
+  std::array<std::atomic<Entry*>, kMaxBlocks> blocks_{};
+};  // class StringInterner
+
+class InternedString {
+public:
+  InternedString() : id_(StringInterner::instance().intern({})) {}
+  explicit InternedString(std::string_view s) : id_(StringInterner::instance().intern(s)) {}
+
+  std::string_view view() const { return StringInterner::instance().view(id_); }
+  StringInterner::Id id() const { return id_; }
+
+  friend bool operator==(InternedString a, InternedString b) { return a.id_ == b.id_; }
+private:
+  StringInterner::Id id_;
+};  // class InternedString
+static_assert(sizeof(InternedString) == 4);
+
+template <>
+struct std::hash<InternedString> {
+  std::size_t operator()(InternedString s) const noexcept {
+    return std::hash<StringInterner::Id>{}(s.id());
+  }
+};
+
+// 驻留名字的 Person
+// 大量重复名字时，每个 Person 只保存 4 字节的 id，名字在全局字符串池中只存一份
+// 拷贝、移动、比较和哈希都只涉及 id, 没有分配
+class InternedPerson {
+private:
+  InternedString name;
+public:
+  template <typename STR>
+  requires std::is_convertible_v<STR, std::string_view>
+  explicit InternedPerson(STR&& n) : name(std::string_view(n)) {}  // 只读取 n, 不需要转发
+  std::string_view get_name() const { return name.view(); }
+  friend bool operator==(const InternedPerson&, const InternedPerson&) = default;
+  friend struct std::hash<InternedPerson>;
+};  // class InternedPerson
+template <>
+struct std::hash<InternedPerson> {
+  std::size_t operator()(const InternedPerson& p) const noexcept {
+    return std::hash<InternedString>{}(p.name);
+  }
+};
@@ -0,0 +1,124 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 11:58:40
+# Desc   : std::string name 与 InternedString name 的内存和构造吞吐对比
+########################################################################
+*/
+/*
+用法: chapter_06_interned_string_benchmark [persons] [distinct_names] [threads]
+默认 1000000 个 Person, 10000 个不同的名字
+*/
+
+#include <algorithm>
+#include <format>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "interned_string.h"
+
+// 和 Person6 一样的构造方式, 只是去掉了打印
+class StringPerson {
+private:
+  std::string name;
+public:
+  template <typename STR>
+  requires std::is_convertible_v<STR, std::string>
+  explicit StringPerson(STR&& n) : name(std::forward<STR>(n)) {}
+  const std::string& get_name() const { return name; }
+  friend bool operator==(const StringPerson&, const StringPerson&) = default;
+};  // class StringPerson
+
+std::vector<std::string> make_names(std::size_t distinct) {
+  std::vector<std::string> names;
+  names.reserve(distinct);
+  for (std::size_t i = 0; i < distinct; ++i) {
+    // 超过 SSO 的长度, 否则 std::string 不会分配堆内存
+    names.push_back(std::format("person_with_a_long_name_{:08}", i));
+  }
+  return names;
+}
+
+std::size_t string_heap_bytes(const std::string& s) {
+  return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+int main(int argc, char** argv) {
+  const std::size_t persons = utils::arg_or(argc, argv, 1, 1'000'000);
+  const std::size_t distinct = std::max<std::size_t>(1, utils::arg_or(argc, argv, 2, 10'000));
+  const std::size_t threads = std::max<std::size_t>(1, utils::arg_or(argc, argv, 3, 4));
+  std::println("persons: {}, distinct names: {}, threads: {}", persons, distinct, threads);
+  auto names = make_names(distinct);
+
+  // 1. 构造吞吐
+  std::vector<StringPerson> string_persons;
+  utils::run_benchmark("construct StringPerson (copy std::string)", persons, [&] {
+    string_persons.clear();
+    string_persons.reserve(persons);
+    for (std::size_t i = 0; i < persons; ++i) {
+      string_persons.emplace_back(names[i % distinct]);
+    }
+  });
+  std::vector<InternedPerson> interned_persons;
+  utils::run_benchmark("construct InternedPerson (intern)", persons, [&] {
+    interned_persons.clear();
+    interned_persons.reserve(persons);
+    for (std::size_t i = 0; i < persons; ++i) {
+      interned_persons.emplace_back(names[i % distinct]);
+    }
+  });
+  utils::run_benchmark(std::format("construct InternedPerson x {} threads", threads), persons, [&] {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        std::vector<InternedPerson> local;
+        local.reserve(persons / threads + 1);
+        for (std::size_t i = t; i < persons; i += threads) {
+          local.emplace_back(names[i % distinct]);
+        }
+        utils::do_not_optimize(local.data());
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+  });
+
+  // 2. 比较: 统计和第一个 Person 同名的个数
+  utils::run_benchmark("compare StringPerson", persons, [&] {
+    std::size_t same = 0;
+    for (const auto& p : string_persons) {
+      same += p == string_persons.front();
+    }
+    utils::do_not_optimize(same);
+  });
+  utils::run_benchmark("compare InternedPerson", persons, [&] {
+    std::size_t same = 0;
+    for (const auto& p : interned_persons) {
+      same += p == interned_persons.front();
+    }
+    utils::do_not_optimize(same);
+  });
+
+  // 3. 内存
+  std::size_t string_bytes = string_persons.size() * sizeof(StringPerson);
+  for (const auto& p : string_persons) {
+    string_bytes += string_heap_bytes(p.get_name());
+  }
+  std::size_t interned_bytes = interned_persons.size() * sizeof(InternedPerson)
+      + StringInterner::instance().memory_usage();
+  std::println("memory StringPerson:   {:>14} bytes ({} bytes/person)",
+      string_bytes, static_cast<double>(string_bytes) / persons);
+  std::println("memory InternedPerson: {:>14} bytes ({} bytes/person, pool {} strings)",
+      interned_bytes, static_cast<double>(interned_bytes) / persons, StringInterner::instance().size());
+  return 0;
+}
@@ -11,10 +11,15 @@
 ########################################################################
 */
 
+#include <cassert>
 #include <print>
 #include <type_traits>
 #include <utility>
 #include "cpp_utils/util.h"
+#include "utils/lifetime_probe.h"
+#include "utils/type_name.h"
+
+#include "interned_string.h"
 
 // 6.1 完美转发简介
 class X {};  // class X
@@ -167,7 +172,7 @@ struct enable_if;
 template <typename T>
 typename std::enable_if<(sizeof(T) > 4)>::type foo() {
   PRINT_CURRENT_FUNCTION_NAME;
-  std::println("sizeof({}) > 4", typeid(T).name());
+  std::println("sizeof({}) > 4", utils::type_name<T>());
 }
 
 /*
@@ -179,7 +184,7 @@ void foo() {
 template <typename T>
 std::enable_if_t<(sizeof(T) > 4), T> foo2() {
   PRINT_CURRENT_FUNCTION_NAME;
-  std::println("sizeof({}) > 4", typeid(T).name());
+  std::println("sizeof({}) > 4", utils::type_name<T>());
   return T();
 }
 
@@ -187,7 +192,7 @@ std::enable_if_t<(sizeof(T) > 4), T> foo2() {
 template <typename T, typename = std::enable_if_t<(sizeof(T) > 4)>>
 void foo3() {
   PRINT_CURRENT_FUNCTION_NAME;
-  std::println("sizeof({}) > 4", typeid(T).name());
+  std::println("sizeof({}) > 4", utils::type_name<T>());
 }
 // 或者
 template <typename T>
@@ -195,14 +200,14 @@ using EnableIfSizeGreater4 = std::enable_if_t<(sizeof(T) > 4)>;
 template <typename T, typename = EnableIfSizeGreater4<T>>
 void foo4() {
   PRINT_CURRENT_FUNCTION_NAME;
-  std::println("sizeof({}) > 4", typeid(T).name());
+  std::println("sizeof({}) > 4", utils::type_name<T>());
 }
 template <typename T, size_t N>
 using EnableIfSizeGreater = std::enable_if_t<(sizeof(T) > N)>;
 template <typename T, typename = EnableIfSizeGreater<T, 4>>
 void foo5() {
   PRINT_CURRENT_FUNCTION_NAME;
-  std::println("sizeof({}) > 4", typeid(T).name());
+  std::println("sizeof({}) > 4", utils::type_name<T>());
 }
 
 void run_foo() {
@@ -446,6 +451,58 @@ public:
   }
 };
 
+// 使用 lifetime probe 统计拷贝和移动次数
+// 上面的 Person 系列通过打印来观察调用了哪个构造函数，这里用 utils::Probed 计数，可以直接断言
+class ProbedPerson {
+private:
+  utils::Probed<std::string, ProbedPerson> name;
+public:
+  template <ConvertibleToString STR>
+  explicit ProbedPerson(STR&& n) : name(std::forward<STR>(n)) {}
+  ProbedPerson(const ProbedPerson& p) = default;
+  ProbedPerson(ProbedPerson&& p) = default;
+};  // class ProbedPerson
+
+void run_person_probe() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::string name = "sname";
+  {
+    utils::LifetimeScope<ProbedPerson> scope;
+    ProbedPerson p1(name);  // STR = std::string&, 拷贝 name
+    assert(1 == scope.counts().copies());
+  }
+  {
+    utils::LifetimeScope<ProbedPerson> scope;
+    ProbedPerson p2("tmp");  // STR = const char(&)[4], 直接由 const char* 构造
+    ProbedPerson p3(std::string("tmp"));  // STR = std::string, 移动
+    assert(0 == scope.counts().copies());
+    assert(1 == scope.counts().move_constructions);
+  }
+  {
+    ProbedPerson p1(name);
+    utils::LifetimeScope<ProbedPerson> scope;
+    ProbedPerson p3(p1);  // 拷贝构造函数
+    ProbedPerson p4(std::move(p1));  // 移动构造函数, 没有拷贝
+    assert(1 == scope.counts().copies());
+    assert(1 == scope.counts().moves());
+  }
+  utils::print_lifetime_report();
+  std::println();
+}
+// 驻留名字的 Person, 见 interned_string.h
+void run_interned_person() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::string name = "sname";
+  InternedPerson p1(name);
+  InternedPerson p2("sname");
+  InternedPerson p3(p1);
+  InternedPerson p4("tmp");
+  static_assert(sizeof(InternedPerson) == 4);
+  assert(p1 == p2 && p2 == p3 && !(p1 == p4));
+  assert(std::hash<InternedPerson>{}(p1) == std::hash<InternedPerson>{}(p2));
+  std::println("p1: '{}', p4: '{}'", p1.get_name(), p4.get_name());
+  std::println();
+}
 
 int main() {
   run_move1();
@@ -460,5 +517,7 @@ int main() {
   run_forbid_special_method_function_3();
   run_forbid_special_method_function_4();
   run_forbid_special_method_function_5();
+  run_person_probe();
+  run_interned_person();
   return 0;
 }
@@ -0,0 +1,128 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 15:20:47
+# Desc   : Buffer: 只能移动的对齐内存块, 用于在流水线各阶段之间零拷贝地传递数据
+########################################################################
+*/
+/*
+1. 和 chapter_06 的 C2/C5 一样删除拷贝构造和拷贝赋值, Buffer b2 = b1; 无法编译
+2. 需要复制时显式调用 clone()
+3. 移动只转移指针，数据的地址不变，所以指向 Buffer 的 BufferView 在 Buffer 被移动后仍然有效
+4. clone / 移动会记录到 utils::lifetime_counters<Buffer>, 可以用 utils::LifetimeScope<Buffer> 断言没有拷贝
+*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "utils/lifetime_probe.h"
+
+// 不拥有内存的切片, 生命周期不能超过对应的 Buffer
+class BufferView {
+public:
+  BufferView() = default;
+  BufferView(const std::byte* data, std::size_t size) : data_(data), size_(size) {}
+
+  const std::byte* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  BufferView subview(std::size_t offset, std::size_t length) const {
+    assert(offset + length <= size_);
+    return {data_ + offset, length};
+  }
+  std::span<const std::byte> span() const { return {data_, size_}; }
+  std::string_view as_string_view() const {
+    return {reinterpret_cast<const char*>(data_), size_};
+  }
+private:
+  const std::byte* data_{nullptr};
+  std::size_t size_{0};
+};  // class BufferView
+
+class Buffer {
+public:
+  static constexpr std::size_t kDefaultAlignment = 64;  // cache line
+
+  Buffer() = default;
+  explicit Buffer(std::size_t capacity, std::size_t alignment = kDefaultAlignment)
+      : data_(capacity == 0 ? nullptr
+            : static_cast<std::byte*>(::operator new(capacity, std::align_val_t{alignment}))),
+        capacity_(capacity),
+        size_(capacity),
+        alignment_(alignment) {}
+  Buffer(const Buffer&) = delete;
+  Buffer& operator=(const Buffer&) = delete;
+  Buffer(Buffer&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        alignment_(other.alignment_) {
+    counters().add(utils::LifetimeCounters::kMoveConstruct);
+  }
+  Buffer& operator=(Buffer&& other) noexcept {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+      size_ = std::exchange(other.size_, 0);
+      alignment_ = other.alignment_;
+      counters().add(utils::LifetimeCounters::kMoveAssign);
+    }
+    return *this;
+  }
+  ~Buffer() { release(); }
+
+  // 唯一会复制数据的地方
+  Buffer clone() const {
+    Buffer copy(capacity_, alignment_);
+    copy.size_ = size_;
+    if (size_ != 0) {
+      std::memcpy(copy.data_, data_, size_);
+    }
+    counters().add(utils::LifetimeCounters::kCopyConstruct);
+    return copy;
+  }
+
+  std::byte* data() { return data_; }
+  const std::byte* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+  std::size_t alignment() const { return alignment_; }
+  bool empty() const { return size_ == 0; }
+  // 只改变有效长度, 不会重新分配
+  void resize(std::size_t size) {
+    assert(size <= capacity_);
+    size_ = size;
+  }
+
+  std::span<std::byte> span() { return {data_, size_}; }
+  std::span<const std::byte> span() const { return {data_, size_}; }
+  BufferView view() const { return {data_, size_}; }
+  BufferView view(std::size_t offset, std::size_t length) const { return view().subview(offset, length); }
+
+  static utils::LifetimeCounters& counters() { return utils::lifetime_counters<Buffer>; }
+
+private:
+  void release() {
+    if (data_ != nullptr) {
+      ::operator delete(data_, std::align_val_t{alignment_});
+      data_ = nullptr;
+    }
+  }
+
+  std::byte* data_{nullptr};
+  std::size_t capacity_{0};
+  std::size_t size_{0};
+  std::size_t alignment_{kDefaultAlignment};
+};  // class Buffer
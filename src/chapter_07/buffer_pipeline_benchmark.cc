@@ -0,0 +1,205 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 15:58:21
+# Desc   : reader -> parser -> writer 三阶段流水线, Buffer(移动) 与 std::vector<char>(拷贝) 对比
+########################################################################
+*/
+/*
+用法: chapter_07_buffer_pipeline_benchmark [chunks] [chunk_bytes]
+1. reader: 把数据写入一个 chunk (相当于 read(2), 每个 chunk 只写一次)
+2. parser: 按行切分
+3. writer: 对每一行计算校验和 (相当于 write(2))
+Buffer 版本在阶段之间只移动, 行是指向 Buffer 的 BufferView
+vector 版本在阶段之间按值传递, 行被复制成 std::string, 这是按值传参时常见的写法
+最后用 utils::LifetimeScope<Buffer> 断言 Buffer 版本没有任何拷贝
+*/
+
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/benchmark.h"
+#include "utils/lifetime_probe.h"
+
+#include "buffer.h"
+
+// 有界阻塞队列, push 接受右值, 只移动元素
+template <typename T>
+class BlockingQueue {
+public:
+  explicit BlockingQueue(std::size_t capacity) : capacity_(capacity) {}
+  void push(T&& item) {
+    std::unique_lock lock(mutex_);
+    not_full_.wait(lock, [this] { return items_.size() < capacity_; });
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+  }
+  std::optional<T> pop() {
+    std::unique_lock lock(mutex_);
+    not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    T item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return item;
+  }
+  void close() {
+    std::lock_guard lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+private:
+  std::size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<T> items_;
+  bool closed_{false};
+};  // class BlockingQueue
+
+std::string make_source(std::size_t bytes) {
+  std::string source;
+  for (std::size_t i = 0; source.size() < bytes; ++i) {
+    source += std::format("record {} value {}\n", i, i * 31);
+  }
+  source.resize(bytes);
+  source.back() = '\n';
+  return source;
+}
+
+std::uint64_t checksum(std::string_view line) {
+  std::uint64_t h = 1469598103934665603ULL;
+  for (char c : line) {
+    h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return h;
+}
+
+struct Parsed {
+  Buffer buffer;
+  std::vector<BufferView> lines;  // 指向 buffer, buffer 移动后仍然有效
+};  // struct Parsed
+
+std::uint64_t run_buffer_pipeline(const std::string& source, std::size_t chunks) {
+  BlockingQueue<Buffer> read_queue(4);
+  BlockingQueue<Parsed> parse_queue(4);
+  std::uint64_t result = 0;
+  std::thread reader([&] {
+    for (std::size_t i = 0; i < chunks; ++i) {
+      Buffer buf(source.size());
+      std::memcpy(buf.data(), source.data(), source.size());  // 相当于 read(2)
+      read_queue.push(std::move(buf));
+    }
+    read_queue.close();
+  });
+  std::thread parser([&] {
+    while (auto buf = read_queue.pop()) {
+      Parsed parsed{std::move(*buf), {}};
+      std::string_view text = parsed.buffer.view().as_string_view();
+      std::size_t begin = 0;
+      for (std::size_t end = text.find('\n'); end != std::string_view::npos; end = text.find('\n', begin)) {
+        parsed.lines.push_back(parsed.buffer.view(begin, end - begin));
+        begin = end + 1;
+      }
+      parse_queue.push(std::move(parsed));
+    }
+    parse_queue.close();
+  });
+  std::thread writer([&] {
+    while (auto parsed = parse_queue.pop()) {
+      for (const auto& line : parsed->lines) {
+        result += checksum(line.as_string_view());
+      }
+    }
+  });
+  reader.join();
+  parser.join();
+  writer.join();
+  return result;
+}
+
+// 对照组: 每个阶段都按值接收并复制
+using Chunk = std::vector<char>;
+std::vector<std::string> parse_copy(Chunk chunk) {
+  std::vector<std::string> lines;
+  std::string_view text(chunk.data(), chunk.size());
+  std::size_t begin = 0;
+  for (std::size_t end = text.find('\n'); end != std::string_view::npos; end = text.find('\n', begin)) {
+    lines.emplace_back(text.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  return lines;
+}
+std::uint64_t run_copy_pipeline(const std::string& source, std::size_t chunks) {
+  BlockingQueue<Chunk> read_queue(4);
+  BlockingQueue<std::vector<std::string>> parse_queue(4);
+  std::uint64_t result = 0;
+  std::thread reader([&] {
+    for (std::size_t i = 0; i < chunks; ++i) {
+      Chunk chunk(source.begin(), source.end());
+      read_queue.push(std::move(chunk));
+    }
+    read_queue.close();
+  });
+  std::thread parser([&] {
+    while (auto chunk = read_queue.pop()) {
+      auto lines = parse_copy(*chunk);  // 按值传参, 再拷贝一次
+      parse_queue.push(std::move(lines));
+    }
+    parse_queue.close();
+  });
+  std::thread writer([&] {
+    while (auto lines = parse_queue.pop()) {
+      for (const auto& line : *lines) {
+        result += checksum(line);
+      }
+    }
+  });
+  reader.join();
+  parser.join();
+  writer.join();
+  return result;
+}
+
+int main(int argc, char** argv) {
+  const std::size_t chunks = utils::arg_or(argc, argv, 1, 2'000);
+  const std::size_t chunk_bytes = utils::arg_or(argc, argv, 2, 64 * 1024);
+  const std::string source = make_source(chunk_bytes);
+  std::println("chunks: {}, chunk bytes: {}", chunks, chunk_bytes);
+
+  std::uint64_t buffer_result = 0;
+  std::uint64_t copy_result = 0;
+  utils::LifetimeScope<Buffer> scope;
+  auto buffer_bench = utils::run_benchmark("Buffer pipeline (move only), per chunk", chunks, [&] {
+    buffer_result = run_buffer_pipeline(source, chunks);
+  });
+  auto counts = scope.counts();
+  auto copy_bench = utils::run_benchmark("std::vector pipeline (by value), per chunk", chunks, [&] {
+    copy_result = run_copy_pipeline(source, chunks);
+  });
+  assert(buffer_result == copy_result);
+  assert(0 == counts.copies());
+
+  const double bytes = static_cast<double>(chunks * chunk_bytes);
+  std::println("Buffer throughput: {:.1f} MB/s, vector throughput: {:.1f} MB/s",
+      bytes / buffer_bench.ns * 1e3, bytes / copy_bench.ns * 1e3);
+  std::println("Buffer copies: {}, moves: {}", counts.copies(), counts.moves());
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 14:10:33
+# Desc   : fixed_string<N>: 容量固定、不分配内存、可以做模板实参的字符串
+########################################################################
+*/
+/*
+7.4 中, 字符串字面量按引用传递时是 char[L] 类型, 长度不同就是不同类型; 按值传递时又会退化成 const char*
+fixed_string<N>:
+1. N 是容量, 从字面量推导时 N 就是字面量的长度(不含 '\0')
+2. 所有成员都是 public 的, 是一个结构化类型(structural type), 可以做非类型模板参数(C++20)
+  template <fixed_string Name> struct X {};  X<"hello"> x;
+3. 拼接、比较都是 constexpr 的, 拼接结果的容量是两者之和
+4. 不同容量的 fixed_string 可以互相比较(按内容)
+5. 不会分配内存, 超过容量时抛出 std::length_error(常量求值时就是编译错误)
+*/
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+
+template <std::size_t N>
+struct fixed_string {
+  // 未使用的部分必须保持为 '\0', 作为模板实参时所有成员都参与比较
+  char data[N + 1]{};
+  std::size_t length{0};
+
+  constexpr fixed_string() = default;
+  constexpr fixed_string(const char (&s)[N + 1]) : length(N) {
+    std::copy_n(s, N, data);
+  }
+  constexpr explicit fixed_string(std::string_view s) : length(s.size()) {
+    if (s.size() > N) {
+      throw std::length_error("fixed_string: capacity exceeded");
+    }
+    std::copy_n(s.data(), s.size(), data);
+  }
+
+  static constexpr std::size_t capacity() { return N; }
+  constexpr std::size_t size() const { return length; }
+  constexpr bool empty() const { return length == 0; }
+  constexpr const char* c_str() const { return data; }
+  constexpr const char* begin() const { return data; }
+  constexpr const char* end() const { return data + length; }
+  constexpr char operator[](std::size_t i) const { return data[i]; }
+  constexpr std::string_view view() const { return {data, length}; }
+  constexpr operator std::string_view() const { return view(); }
+
+  // 追加, 超过容量时抛出 std::length_error
+  constexpr fixed_string& append(std::string_view s) {
+    if (length + s.size() > N) {
+      throw std::length_error("fixed_string: capacity exceeded");
+    }
+    std::copy_n(s.data(), s.size(), data + length);
+    length += s.size();
+    return *this;
+  }
+};  // struct fixed_string
+
+// 从字面量推导: "hello" 是 const char[6], N = 5
+template <std::size_t N>
+fixed_string(const char (&)[N]) -> fixed_string<N - 1>;
+
+template <std::size_t N, std::size_t M>
+constexpr fixed_string<N + M> operator+(const fixed_string<N>& a, const fixed_string<M>& b) {
+  fixed_string<N + M> result;
+  std::copy_n(a.data, a.length, result.data);
+  std::copy_n(b.data, b.length, result.data + a.length);
+  result.length = a.length + b.length;
+  return result;
+}
+template <std::size_t N, std::size_t M>
+constexpr fixed_string<N + M - 1> operator+(const fixed_string<N>& a, const char (&b)[M]) {
+  return a + fixed_string<M - 1>(b);
+}
+template <std::size_t N, std::size_t M>
+constexpr fixed_string<N + M - 1> operator+(const char (&a)[N], const fixed_string<M>& b) {
+  return fixed_string<N - 1>(a) + b;
+}
+
+template <std::size_t N, std::size_t M>
+constexpr bool operator==(const fixed_string<N>& a, const fixed_string<M>& b) {
+  return a.view() == b.view();
+}
+template <std::size_t N, std::size_t M>
+constexpr std::strong_ordering operator<=>(const fixed_string<N>& a, const fixed_string<M>& b) {
+  return a.view() <=> b.view();
+}
+template <std::size_t N>
+constexpr bool operator==(const fixed_string<N>& a, std::string_view b) {
+  return a.view() == b;
+}
+
+template <std::size_t N>
+struct std::hash<fixed_string<N>> {
+  std::size_t operator()(const fixed_string<N>& s) const noexcept {
+    return std::hash<std::string_view>{}(s.view());
+  }
+};
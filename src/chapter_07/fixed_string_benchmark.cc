@@ -0,0 +1,83 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 14:52:08
+# Desc   : fixed_string<N> 与 std::string 的短 key 查找、拼接对比
+########################################################################
+*/
+/*
+用法: chapter_07_fixed_string_benchmark [lookups] [keys]
+1. 短 key 在 std::map / std::unordered_map 中的查找
+2. 热循环中的拼接: "metric." + key + ".count", 结果超过 SSO 长度时 std::string 需要分配
+*/
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <print>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "fixed_string.h"
+
+using Key = fixed_string<16>;
+
+template <typename Map, typename K>
+void bench_lookup(const char* name, const std::vector<K>& keys, std::size_t lookups) {
+  Map map;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    map.emplace(keys[i], static_cast<int>(i));
+  }
+  utils::run_benchmark(name, lookups, [&] {
+    long long sum = 0;
+    for (std::size_t i = 0; i < lookups; ++i) {
+      sum += map.find(keys[(i * 7919) % keys.size()])->second;
+    }
+    utils::do_not_optimize(sum);
+  });
+}
+
+int main(int argc, char** argv) {
+  const std::size_t lookups = utils::arg_or(argc, argv, 1, 5'000'000);
+  const std::size_t key_count = std::max<std::size_t>(1, utils::arg_or(argc, argv, 2, 1'000));
+  std::vector<std::string> string_keys;
+  std::vector<Key> fixed_keys;
+  for (std::size_t i = 0; i < key_count; ++i) {
+    string_keys.push_back(std::format("key_{}", i));
+    fixed_keys.emplace_back(string_keys.back());
+  }
+
+  std::println("short-key lookups, {} keys", key_count);
+  bench_lookup<std::map<std::string, int>>("  std::map<std::string>", string_keys, lookups);
+  bench_lookup<std::map<Key, int, std::less<>>>("  std::map<fixed_string<16>>", fixed_keys, lookups);
+  bench_lookup<std::unordered_map<std::string, int>>("  std::unordered_map<std::string>", string_keys, lookups);
+  bench_lookup<std::unordered_map<Key, int>>("  std::unordered_map<fixed_string<16>>", fixed_keys, lookups);
+
+  std::println("concatenation in a hot loop");
+  utils::run_benchmark("  std::string", lookups, [&] {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < lookups; ++i) {
+      std::string s = "metric." + string_keys[i % key_count] + ".count";
+      total += s.size();
+    }
+    utils::do_not_optimize(total);
+  });
+  utils::run_benchmark("  fixed_string", lookups, [&] {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < lookups; ++i) {
+      auto s = "metric." + fixed_keys[i % key_count] + ".count";  // fixed_string<29>
+      total += s.size();
+      utils::do_not_optimize(s);
+    }
+    utils::do_not_optimize(total);
+  });
+  return 0;
+}
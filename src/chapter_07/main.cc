@@ -11,12 +11,21 @@
 ########################################################################
 */
 
+#include <cassert>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <print>
+#include <string>
+#include <vector>
 
 
 #include "cpp_utils/util.h"
+#include "utils/lifetime_probe.h"
+
+#include "buffer.h"
+#include "fixed_string.h"
+#include "param_policy.h"
 // 7.1 传值
 template <typename T>
 void print_v(T arg) {
@@ -110,6 +119,67 @@ void run_pass_r() {
   // pass_r_2(i);  // T = int&, arg = int&
 }
 
+// 使用 lifetime probe 验证三种传参方式的拷贝次数
+void run_pass_probe() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  using Probe = utils::LifetimeProbe<struct PassProbeTag>;
+  Probe p{42};
+  {
+    utils::LifetimeScope<struct PassProbeTag> scope;
+    print_v(p);  // 传值: 拷贝一次
+    assert(1 == scope.counts().copies());
+  }
+  {
+    utils::LifetimeScope<struct PassProbeTag> scope;
+    print_v(std::move(p));  // 传值: 移动一次
+    assert(0 == scope.counts().copies());
+    assert(1 == scope.counts().moves());
+  }
+  {
+    utils::LifetimeScope<struct PassProbeTag> scope;
+    print_r(p);  // 传 const 引用: 没有拷贝和移动
+    pass_r(p);  // 转发引用: 没有拷贝和移动
+    pass_r(Probe{1});  // 转发引用绑定到临时对象: 只有一次构造
+    assert(0 == scope.counts().copies());
+    assert(0 == scope.counts().moves());
+  }
+  utils::print_lifetime_report();
+  std::println();
+}
+
+// 由类型决定传值还是传引用: param_t<T>, 见 param_policy.h
+struct Pair16 {
+  long long a;
+  long long b;
+};  // struct Pair16
+struct Block64 {
+  long long v[8];
+};  // struct Block64
+SAME_TYPE(param_t<int>, int);
+SAME_TYPE(param_t<Pair16>, Pair16);  // 两个寄存器
+SAME_TYPE(param_t<Block64>, const Block64&);  // 超过两个寄存器
+SAME_TYPE(param_t<std::string>, const std::string&);  // 不可平凡拷贝
+SAME_TYPE(param_t<int[4]>, const int(&)[4]);  // 数组不退化
+
+void run_param_policy() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::vector<int> ints{3, 1, 4};
+  param_policy::foreach(ints.begin(), ints.end(), [](param_t<int> i) {
+    std::println("int by value: {}", i);
+  });
+  std::vector<std::string> strs{"hello", "world"};
+  param_policy::foreach(strs.begin(), strs.end(), [](param_t<std::string> s) {
+    std::println("string by const reference: {}", s);
+  });
+  std::println("max<int>(1, 2) = {}", param_policy::max<int>(1, 2));
+  const std::string& m = param_policy::max<std::string>(strs[0], strs[1]);
+  std::println("max<std::string> = {}, refers to strs[1]: {}", m, &m == &strs[1]);
+  param_policy::call([](param_t<int> i, param_t<std::string> s) {
+    std::println("call: {} {}", i, s);
+  }, 42, strs[0]);
+  std::println();
+}
+
 // 7.3 使用 std::ref() 和 std::cref()
 void print_s(const std::string& arg) {
  std::cout << arg << std::endl;
@@ -168,6 +238,31 @@ void run_foo() {
   foo2("hi", "guy");
 }
 
+// 使用 fixed_string<N>, 见 fixed_string.h
+// 长度不同的字面量推导出不同的 N，但可以按内容比较，也不会退化成指针
+template <std::size_t L1, std::size_t L2>
+bool foo5(const fixed_string<L1>& arg1, const fixed_string<L2>& arg2) {
+  return arg1 == arg2;
+}
+// 结构化类型可以做非类型模板参数
+template <fixed_string Name>
+struct Named {
+  static constexpr std::string_view name() { return Name.view(); }
+};  // struct Named
+void run_fixed_string() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::println("foo5(\"hi\", \"guy\") = {}", foo5(fixed_string("hi"), fixed_string("guy")));
+  constexpr fixed_string hello = "hello";
+  constexpr auto hello_world = hello + ", " + fixed_string("world");  // 编译期拼接
+  static_assert(hello_world == fixed_string("hello, world"));
+  static_assert(hello_world.capacity() == 12 && hello_world.size() == 12);
+  static_assert(hello < fixed_string("world"));
+  static_assert(Named<"person">::name() == "person");
+  static_assert(std::is_same_v<Named<"person">, Named<fixed_string("person")>>);
+  std::println("{}, {}", hello_world.view(), Named<"person">::name());
+  std::println();
+}
+
 // 7.5 处理返回值
 // 当函数返回引用类型时，引用的原始对象可能被销毁
 void reference_and_then_delete() {
@@ -244,15 +339,46 @@ void run_remove_reference() {
   // auto ret_2 = ret_v_auto<int&>(i);  // T = int&, p = int&
 }
 
+// 只能移动的 Buffer, 见 buffer.h
+// 按值返回和传递都只会移动(或者被省略), 拷贝无法编译, 需要复制时必须显式调用 clone()
+static_assert(!std::is_copy_constructible_v<Buffer>);
+static_assert(!std::is_copy_assignable_v<Buffer>);
+static_assert(std::is_nothrow_move_constructible_v<Buffer>);
+Buffer read_stage(std::string_view text) {
+  Buffer buf(text.size());
+  std::memcpy(buf.data(), text.data(), text.size());
+  return buf;  // NRVO 或移动
+}
+BufferView parse_stage(const Buffer& buf) {
+  return buf.view(0, buf.view().as_string_view().find(' '));  // 第一个单词
+}
+void run_buffer() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  utils::LifetimeScope<Buffer> scope;
+  Buffer buf = read_stage("hello buffer");
+  BufferView word = parse_stage(buf);
+  Buffer moved = std::move(buf);  // 只移动指针, word 仍然有效
+  // Buffer copied = moved;  // 编译错误: 拷贝构造函数被删除
+  assert(0 == scope.counts().copies());
+  Buffer cloned = moved.clone();  // 显式复制
+  assert(1 == scope.counts().copies());
+  std::println("word: {}, cloned: {}", word.as_string_view(), cloned.view().as_string_view());
+  std::println();
+}
+
 int main() {
   run_print_v();
   run_print_r();
   run_out_r();
   run_pass_r();
+  run_pass_probe();
+  run_param_policy();
   run_print_t();
   run_foo();
+  run_fixed_string();
   run_ret_r();
   run_ret_v();
+  run_buffer();
   return 0;
 }
 
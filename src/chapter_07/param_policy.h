@@ -0,0 +1,63 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 13:05:12
+# Desc   : param_t<T>: 在编译期选择传值(print_v)还是传 const 引用(print_r)
+########################################################################
+*/
+/*
+规则:
+1. 可平凡拷贝(trivially copyable)并且不超过两个寄存器大小的类型按值传递
+  在 x86-64 SysV / AArch64 ABI 中，这样的参数可以直接放在寄存器里，不需要经过内存
+2. 其他类型(比如 std::string，或者较大的结构体)按 const T& 传递，避免拷贝
+3. 数组按 const T& 传递, 不会退化成指针(见 7.4)
+
+注意 param_t<T> 出现在函数参数中时，T 无法被推导(非推导上下文)
+所以它适合用在 T 已知的地方，比如由迭代器的 value_type 决定参数类型，或者显式指定 T
+*/
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+template <typename T>
+inline constexpr bool pass_by_value_v =
+    std::is_trivially_copyable_v<T> && !std::is_array_v<T> && sizeof(T) <= 2 * sizeof(void*);
+
+template <typename T>
+using param_t = std::conditional_t<pass_by_value_v<T>, T, const T&>;
+
+namespace param_policy {
+
+// 参考 chapter_11 的 foreach, 元素按 param_t<value_type> 传给 op
+template <typename Iter, typename Callable>
+void foreach(Iter current, Iter end, Callable op) {
+  using value_type = std::iter_value_t<Iter>;
+  while (current != end) {
+    std::invoke(op, static_cast<param_t<value_type>>(*current));
+    ++current;
+  }
+}
+
+// 参考 chapter_11 的 call, 实参按 param_t 传给 op
+// 注意: 只适用于只读参数, 需要修改或转移所有权的参数仍然应该使用转发引用
+template <typename Callable, typename... Args>
+decltype(auto) call(Callable&& op, const Args&... args) {
+  return std::invoke(std::forward<Callable>(op), static_cast<param_t<Args>>(args)...);
+}
+
+// 需要显式指定 T, 比如 param_policy::max<std::string>(a, b)
+// 返回类型和参数类型一致: 小类型返回值，大类型返回调用者对象的引用
+template <typename T>
+param_t<T> max(param_t<T> a, param_t<T> b) {
+  return b < a ? a : b;
+}
+
+}  // namespace param_policy
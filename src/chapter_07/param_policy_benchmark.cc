@@ -0,0 +1,99 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 13:41:26
+# Desc   : 传值(寄存器)与传 const 引用(内存)的调用开销对比
+########################################################################
+*/
+/*
+用法: chapter_07_param_policy_benchmark [calls]
+对 int、16 字节结构体、64 字节结构体、std::string 分别测试
+1. by value: 和 print_v 一样按值传递
+2. by const&: 和 print_r 一样按 const 引用传递
+3. param_t: 由 param_t<T> 决定
+被调用函数都是 UTILS_NOINLINE, 保证参数真的按 ABI 传递
+*/
+
+#include <format>
+#include <print>
+#include <string>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "param_policy.h"
+
+struct Pair16 {
+  long long a;
+  long long b;
+};  // struct Pair16
+struct Block64 {
+  long long v[8];
+};  // struct Block64
+
+long long value_of(int x) { return x; }
+long long value_of(const Pair16& x) { return x.a ^ x.b; }
+long long value_of(const Block64& x) { return x.v[0] ^ x.v[7]; }
+long long value_of(const std::string& x) { return static_cast<long long>(x.size()); }
+
+template <typename T>
+UTILS_NOINLINE long long by_value(T x) { return value_of(x); }
+template <typename T>
+UTILS_NOINLINE long long by_cref(const T& x) { return value_of(x); }
+template <typename T>
+UTILS_NOINLINE long long by_param(param_t<T> x) { return value_of(x); }
+
+template <typename T>
+void bench(const char* name, const std::vector<T>& inputs, std::size_t calls) {
+  std::println("{} (sizeof = {}, param_t = {})", name, sizeof(T),
+      pass_by_value_v<T> ? "by value" : "by const&");
+  const std::size_t mask = inputs.size() - 1;  // inputs.size() 是 2 的幂
+  utils::run_benchmark(std::format("  {} by value", name), calls, [&] {
+    long long sum = 0;
+    for (std::size_t i = 0; i < calls; ++i) {
+      sum += by_value<T>(inputs[i & mask]);
+    }
+    utils::do_not_optimize(sum);
+  });
+  utils::run_benchmark(std::format("  {} by const&", name), calls, [&] {
+    long long sum = 0;
+    for (std::size_t i = 0; i < calls; ++i) {
+      sum += by_cref<T>(inputs[i & mask]);
+    }
+    utils::do_not_optimize(sum);
+  });
+  utils::run_benchmark(std::format("  {} by param_t", name), calls, [&] {
+    long long sum = 0;
+    for (std::size_t i = 0; i < calls; ++i) {
+      sum += by_param<T>(inputs[i & mask]);
+    }
+    utils::do_not_optimize(sum);
+  });
+}
+
+int main(int argc, char** argv) {
+  const std::size_t calls = utils::arg_or(argc, argv, 1, 20'000'000);
+  constexpr std::size_t kInputs = 64;
+  std::vector<int> ints;
+  std::vector<Pair16> pairs;
+  std::vector<Block64> blocks;
+  std::vector<std::string> strings;
+  for (std::size_t i = 0; i < kInputs; ++i) {
+    auto v = static_cast<long long>(i);
+    ints.push_back(static_cast<int>(i));
+    pairs.push_back({v, v * 3});
+    blocks.push_back({{v, v + 1, v + 2, v + 3, v + 4, v + 5, v + 6, v + 7}});
+    // 超过 SSO 长度, 按值传递时每次都要分配
+    strings.push_back(std::format("a string longer than the small buffer {}", i));
+  }
+  bench("int", ints, calls);
+  bench("Pair16", pairs, calls);
+  bench("Block64", blocks, calls);
+  bench("std::string", strings, calls / 10);
+  return 0;
+}
@@ -0,0 +1,301 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 19:40:03
+# Desc   :
+########################################################################
+*/
+
+#include "affinity_thread.h"
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace affinity {
+
+namespace {
+
+thread_local ThreadArena* t_arena = nullptr;
+
+std::size_t page_size() {
+  static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+std::size_t round_up_to_page(std::size_t n) {
+  const std::size_t page = page_size();
+  return (n + page - 1) / page * page;
+}
+
+void* map_memory(std::size_t bytes, int extra_flags) {
+  void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  if (p == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+// 页面在第一次访问时才会分配, 所以 mbind 必须在访问之前调用
+// MPOL_PREFERRED: 节点内存不足时可以回退到其他节点; 失败(比如没有 NUMA 支持)时忽略
+void bind_to_node(void* addr, std::size_t bytes, int node) {
+  constexpr std::size_t kMaskBits = 1024;
+  constexpr std::size_t kWordBits = 8 * sizeof(unsigned long);
+  if (node < 0 || static_cast<std::size_t>(node) >= kMaskBits) {
+    return;
+  }
+  unsigned long mask[kMaskBits / kWordBits]{};
+  mask[node / kWordBits] |= 1UL << (node % kWordBits);
+  ::syscall(SYS_mbind, addr, bytes, MPOL_PREFERRED, mask, kMaskBits + 1, 0);
+}
+
+std::int64_t clock_ns(clockid_t clock) {
+  timespec ts{};
+  if (::clock_gettime(clock, &ts) != 0) {
+    return 0;
+  }
+  return std::int64_t{ts.tv_sec} * 1'000'000'000 + ts.tv_nsec;
+}
+
+}  // namespace
+
+ThreadArena::ThreadArena(std::size_t capacity, int node)
+    : capacity_(round_up_to_page(capacity)), node_(node) {
+  if (capacity_ != 0) {
+    data_ = static_cast<std::byte*>(map_memory(capacity_, 0));
+    bind_to_node(data_, capacity_, node_);
+  }
+}
+
+ThreadArena::~ThreadArena() {
+  if (data_ != nullptr) {
+    ::munmap(data_, capacity_);
+  }
+}
+
+void* ThreadArena::allocate(std::size_t bytes, std::size_t alignment) {
+  const std::size_t offset = (used_ + alignment - 1) / alignment * alignment;
+  if (offset > capacity_ || bytes > capacity_ - offset) {
+    throw std::bad_alloc();
+  }
+  used_ = offset + bytes;
+  return data_ + offset;
+}
+
+ThreadArena* this_thread_arena() {
+  return t_arena;
+}
+
+std::chrono::nanoseconds this_thread_cpu_time() {
+  return std::chrono::nanoseconds(clock_ns(CLOCK_THREAD_CPUTIME_ID));
+}
+
+int current_cpu() {
+  return ::sched_getcpu();
+}
+
+// /sys/devices/system/cpu/cpuN/ 下有一个 nodeM 链接
+int numa_node_of_cpu(int cpu) {
+  std::error_code ec;
+  const std::filesystem::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.starts_with("node") && name.size() > 4) {
+      return std::stoi(name.substr(4));
+    }
+  }
+  return -1;
+}
+
+int numa_node_count() {
+  std::error_code ec;
+  int count = 0;
+  for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.starts_with("node") && name.size() > 4 && name.find_first_not_of("0123456789", 4) == std::string::npos) {
+      ++count;
+    }
+  }
+  return count == 0 ? 1 : count;
+}
+
+struct AffinityThread::State {
+  ThreadOptions options;
+  std::move_only_function<void()> task;
+  std::unique_ptr<ThreadArena> arena;
+  void* stack{nullptr};
+  std::size_t stack_bytes{0};  // 包含保护页
+  int node{-1};
+  pthread_t handle{};
+  bool joined{false};
+  std::atomic<bool> finished{false};
+  std::atomic<std::int64_t> cpu_ns{0};
+
+  ~State() {
+    if (stack != nullptr) {
+      ::munmap(stack, stack_bytes);
+    }
+  }
+
+  static void* run(void* arg) {
+    auto* self = static_cast<State*>(arg);
+    t_arena = self->arena.get();
+    if (!self->options.name.empty()) {
+      // Linux 限制线程名最多 15 个字符
+      ::pthread_setname_np(::pthread_self(), self->options.name.substr(0, 15).c_str());
+    }
+    try {
+      self->task();
+    } catch (...) {
+      std::terminate();  // 和 std::thread 一样
+    }
+    self->task = nullptr;
+    self->cpu_ns.store(clock_ns(CLOCK_THREAD_CPUTIME_ID), std::memory_order_relaxed);
+    self->finished.store(true, std::memory_order_release);
+    t_arena = nullptr;
+    return nullptr;
+  }
+};  // struct AffinityThread::State
+
+void AffinityThread::StateDeleter::operator()(State* state) const {
+  delete state;
+}
+
+void AffinityThread::start(ThreadOptions options, std::move_only_function<void()> task) {
+  std::unique_ptr<State, StateDeleter> state(new State());
+  state->options = std::move(options);
+  state->task = std::move(task);
+  const ThreadOptions& opts = state->options;
+  if (opts.numa_local && !opts.cpus.empty()) {
+    state->node = numa_node_of_cpu(opts.cpus.front());
+  }
+
+  pthread_attr_t attr;
+  ::pthread_attr_init(&attr);
+  struct AttrGuard {
+    pthread_attr_t* attr;
+    ~AttrGuard() { ::pthread_attr_destroy(attr); }
+  } attr_guard{&attr};
+
+  if (!opts.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : opts.cpus) {
+      CPU_SET(cpu, &set);
+    }
+    if (int rc = ::pthread_attr_setaffinity_np(&attr, sizeof(set), &set); rc != 0) {
+      throw std::system_error(rc, std::generic_category(), "pthread_attr_setaffinity_np");
+    }
+  }
+
+  // 需要指定栈的位置时自己分配, 最低的一页作为保护页
+  if (opts.stack_size != 0 || state->node >= 0) {
+    std::size_t size = opts.stack_size;
+    if (size == 0 && ::pthread_attr_getstacksize(&attr, &size) != 0) {
+      size = 8 * 1024 * 1024;
+    }
+    size = round_up_to_page(std::max<std::size_t>(size, PTHREAD_STACK_MIN));
+    state->stack_bytes = size + page_size();
+    state->stack = map_memory(state->stack_bytes, MAP_STACK);
+    ::mprotect(state->stack, page_size(), PROT_NONE);
+    auto* usable = static_cast<std::byte*>(state->stack) + page_size();
+    bind_to_node(usable, size, state->node);
+    if (int rc = ::pthread_attr_setstack(&attr, usable, size); rc != 0) {
+      throw std::system_error(rc, std::generic_category(), "pthread_attr_setstack");
+    }
+  }
+
+  if (opts.arena_size != 0) {
+    state->arena = std::make_unique<ThreadArena>(opts.arena_size, state->node);
+  }
+
+  if (int rc = ::pthread_create(&state->handle, &attr, &State::run, state.get()); rc != 0) {
+    throw std::system_error(rc, std::generic_category(), "pthread_create");
+  }
+  state_ = std::move(state);
+}
+
+AffinityThread& AffinityThread::operator=(AffinityThread&& other) noexcept {
+  if (this != &other) {
+    if (joinable()) {
+      join();
+    }
+    state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+AffinityThread::~AffinityThread() {
+  if (joinable()) {
+    join();
+  }
+}
+
+bool AffinityThread::joinable() const {
+  return state_ != nullptr && !state_->joined;
+}
+
+void AffinityThread::join() {
+  if (!joinable()) {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument), "AffinityThread::join");
+  }
+  if (::pthread_equal(state_->handle, ::pthread_self())) {
+    throw std::system_error(std::make_error_code(std::errc::resource_deadlock_would_occur), "AffinityThread::join");
+  }
+  if (int rc = ::pthread_join(state_->handle, nullptr); rc != 0) {
+    throw std::system_error(rc, std::generic_category(), "pthread_join");
+  }
+  state_->joined = true;
+  // 线程已经结束, 可以释放栈和 arena; 保留 State 以便查询 cpu_time()
+  if (state_->stack != nullptr) {
+    ::munmap(state_->stack, state_->stack_bytes);
+    state_->stack = nullptr;
+  }
+  state_->arena.reset();
+}
+
+pthread_t AffinityThread::native_handle() const {
+  return state_ != nullptr ? state_->handle : pthread_t{};
+}
+
+const ThreadOptions& AffinityThread::options() const {
+  static const ThreadOptions kEmpty;
+  return state_ != nullptr ? state_->options : kEmpty;
+}
+
+int AffinityThread::numa_node() const {
+  return state_ != nullptr ? state_->node : -1;
+}
+
+std::chrono::nanoseconds AffinityThread::cpu_time() const {
+  if (state_ == nullptr) {
+    return std::chrono::nanoseconds{0};
+  }
+  if (state_->finished.load(std::memory_order_acquire)) {
+    return std::chrono::nanoseconds(state_->cpu_ns.load(std::memory_order_relaxed));
+  }
+  // 线程还在运行(或者正在退出), 没有 join 之前 handle 一定有效
+  clockid_t clock;
+  if (::pthread_getcpuclockid(state_->handle, &clock) != 0) {
+    return std::chrono::nanoseconds(state_->cpu_ns.load(std::memory_order_relaxed));
+  }
+  return std::chrono::nanoseconds(clock_ns(clock));
+}
+
+}  // namespace affinity
@@ -0,0 +1,129 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 19:12:40
+# Desc   : AffinityThread: 可以绑定 CPU、设置线程名、在本地 NUMA 节点上分配栈和 arena 的线程(Linux)
+########################################################################
+*/
+/*
+构造函数和 8.4 的 thread 一样用 enable_if 约束, 使用 AffinityThread 对象构造另一个 AffinityThread 时
+始终选择移动构造函数(拷贝构造函数是删除的), 而不是转发构造函数
+1. ThreadOptions::cpus: 线程创建时就绑定到这些 CPU 上(pthread_attr_setaffinity_np), 不会先在别的 CPU 上运行
+2. ThreadOptions::name: pthread_setname_np, 最多 15 个字符, 在 top -H / perf 中可见
+3. ThreadOptions::numa_local: 栈和 arena 用 mbind 绑定到 cpus[0] 所在的 NUMA 节点
+   不指定时, arena 的内存由线程自己第一次访问, 按 first-touch 策略也会分配在线程当前所在的节点上
+4. cpu_time(): 线程实际使用的 CPU 时间, 线程结束(甚至 join)之后仍然可以查询
+5. 析构时如果还没有 join 则自动 join(和 std::jthread 一样); 栈由 AffinityThread 管理, 所以不支持 detach
+*/
+#pragma once
+
+#include <pthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace affinity {
+
+struct ThreadOptions {
+  std::vector<int> cpus;       // 为空时不绑定
+  std::string name;            // 为空时继承创建者的线程名
+  std::size_t stack_size{0};   // 0 表示默认大小(pthread 的默认值, 通常为 8MB)
+  bool numa_local{false};      // 栈和 arena 分配在 cpus[0] 所在的 NUMA 节点上
+  std::size_t arena_size{0};   // 0 表示不创建 arena
+};  // struct ThreadOptions
+
+// 线程私有的 bump allocator, 只能整体 reset, 不能单独释放
+class ThreadArena {
+public:
+  // node < 0 时不指定节点(first-touch)
+  ThreadArena(std::size_t capacity, int node);
+  ThreadArena(const ThreadArena&) = delete;
+  ThreadArena& operator=(const ThreadArena&) = delete;
+  ~ThreadArena();
+
+  // 空间不足时抛出 std::bad_alloc
+  void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+  void reset() { used_ = 0; }
+
+  std::size_t used() const { return used_; }
+  std::size_t capacity() const { return capacity_; }
+  int node() const { return node_; }
+
+private:
+  std::byte* data_{nullptr};
+  std::size_t capacity_{0};
+  std::size_t used_{0};
+  int node_{-1};
+};  // class ThreadArena
+
+// 当前线程的 arena, 不是由 AffinityThread 创建或没有设置 arena_size 时返回 nullptr
+ThreadArena* this_thread_arena();
+std::chrono::nanoseconds this_thread_cpu_time();
+int current_cpu();
+// 从 /sys/devices/system 读取, 读取失败时返回 -1 / 1
+int numa_node_of_cpu(int cpu);
+int numa_node_count();
+
+class AffinityThread {
+public:
+  AffinityThread() = default;
+
+  template <typename F, typename... Args,
+      typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, AffinityThread> &&
+          !std::is_same_v<std::decay_t<F>, ThreadOptions>>>
+  explicit AffinityThread(F&& f, Args&&... args)
+      : AffinityThread(ThreadOptions{}, std::forward<F>(f), std::forward<Args>(args)...) {}
+
+  // 和 std::thread 一样, f 和 args 会被 decay 拷贝到新线程中
+  template <typename F, typename... Args>
+  AffinityThread(ThreadOptions options, F&& f, Args&&... args) {
+    start(std::move(options),
+        [f = std::forward<F>(f), ... args = std::forward<Args>(args)]() mutable {
+          std::invoke(std::move(f), std::move(args)...);
+        });
+  }
+
+  AffinityThread(const AffinityThread&) = delete;
+  AffinityThread& operator=(const AffinityThread&) = delete;
+  AffinityThread(AffinityThread&&) noexcept = default;
+  AffinityThread& operator=(AffinityThread&& other) noexcept;
+  ~AffinityThread();
+
+  bool joinable() const;
+  void join();
+  pthread_t native_handle() const;
+  const ThreadOptions& options() const;
+  // 栈和 arena 所在的节点, 没有指定时为 -1
+  int numa_node() const;
+  std::chrono::nanoseconds cpu_time() const;
+
+private:
+  struct State;
+  // State 在 .cpp 中定义, 模板构造函数中的 state_ 可能需要析构, 所以不能使用默认的 deleter
+  struct StateDeleter {
+    void operator()(State* state) const;
+  };  // struct StateDeleter
+
+  void start(ThreadOptions options, std::move_only_function<void()> task);
+
+  std::unique_ptr<State, StateDeleter> state_;
+};  // class AffinityThread
+
+}  // namespace affinity
@@ -0,0 +1,204 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 20:05:51
+# Desc   : 绑定 CPU + 本地 NUMA 内存 与 不绑定 + 主线程初始化内存 的带宽对比
+########################################################################
+*/
+/*
+用法: chapter_08_affinity_thread_benchmark [threads] [mb_per_thread] [passes]
+每个线程反复顺序读取自己的缓冲区(受内存带宽限制)
+1. unpinned: 缓冲区由主线程分配并初始化(first-touch 都在主线程所在的节点上), 工作线程不绑定 CPU
+2. pinned: 工作线程绑定到不同的 CPU, 缓冲区从本地节点上的 arena 分配并由自己初始化
+多路服务器上 unpinned 的大部分访问都要跨 socket; 只有一个 NUMA 节点时两者应该接近
+cpu time 来自 AffinityThread::cpu_time(), pinned 的 cpu time 包含线程自己初始化缓冲区的时间
+*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <print>
+#include <set>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "affinity_thread.h"
+
+using affinity::AffinityThread;
+using affinity::ThreadOptions;
+
+struct SweepResult {
+  std::chrono::nanoseconds wall{0};
+  std::chrono::nanoseconds cpu{0};
+  std::size_t cpus_seen{0};
+  std::uint64_t checksum{0};
+};  // struct SweepResult
+
+void fill(std::span<std::uint64_t> data) {
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = i;
+  }
+}
+
+// 只统计读取的时间, 不包括初始化
+void sweep(std::span<const std::uint64_t> data, std::size_t passes, SweepResult& result) {
+  std::set<int> cpus;
+  utils::Stopwatch watch;
+  std::uint64_t sum = 0;
+  for (std::size_t p = 0; p < passes; ++p) {
+    cpus.insert(affinity::current_cpu());
+    for (std::uint64_t x : data) {
+      sum += x;
+    }
+    utils::do_not_optimize(sum);
+  }
+  result.wall = std::chrono::nanoseconds(static_cast<std::int64_t>(watch.elapsed_ns()));
+  result.cpus_seen = cpus.size();
+  result.checksum = sum;
+}
+
+std::vector<int> allowed_cpus() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  std::vector<int> cpus;
+  if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  if (cpus.empty()) {
+    cpus.push_back(0);
+  }
+  return cpus;
+}
+
+// 按节点轮流选择 CPU, 让线程均匀地分布在各个 socket 上
+std::vector<int> spread_cpus(std::size_t threads) {
+  std::vector<std::vector<int>> by_node(affinity::numa_node_count());
+  for (int cpu : allowed_cpus()) {
+    const int node = std::max(affinity::numa_node_of_cpu(cpu), 0);
+    by_node[static_cast<std::size_t>(node) % by_node.size()].push_back(cpu);
+  }
+  std::erase_if(by_node, [](const auto& cpus) { return cpus.empty(); });
+  std::vector<int> result;
+  for (std::size_t i = 0; result.size() < threads; ++i) {
+    const auto& cpus = by_node[i % by_node.size()];
+    result.push_back(cpus[(i / by_node.size()) % cpus.size()]);
+  }
+  return result;
+}
+
+void report(const char* name, const std::vector<SweepResult>& results, std::size_t bytes_per_thread, std::size_t passes) {
+  std::chrono::nanoseconds wall{0};
+  std::chrono::nanoseconds cpu{0};
+  std::size_t migrations = 0;
+  for (const auto& r : results) {
+    wall = std::max(wall, r.wall);
+    cpu += r.cpu;
+    migrations += r.cpus_seen - 1;
+  }
+  const double bytes = static_cast<double>(bytes_per_thread) * passes * results.size();
+  std::println("{:<12} {:8.2f} GB/s, wall {:8.2f} ms, cpu time {:8.2f} ms, cpu changes {}", name,
+      bytes / static_cast<double>(wall.count()), wall.count() / 1e6, cpu.count() / 1e6, migrations);
+}
+
+void run_unpinned(std::size_t threads, std::size_t words, std::size_t passes) {
+  std::vector<std::unique_ptr<std::uint64_t[]>> buffers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    buffers.push_back(std::make_unique_for_overwrite<std::uint64_t[]>(words));
+    fill({buffers.back().get(), words});
+  }
+  std::vector<SweepResult> results(threads);
+  std::vector<AffinityThread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] { sweep({buffers[t].get(), words}, passes, results[t]); });
+  }
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers[t].join();
+    results[t].cpu = workers[t].cpu_time();
+  }
+  report("unpinned", results, words * sizeof(std::uint64_t), passes);
+}
+
+void run_pinned(std::size_t threads, std::size_t words, std::size_t passes) {
+  const auto cpus = spread_cpus(threads);
+  std::vector<SweepResult> results(threads);
+  std::vector<AffinityThread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    ThreadOptions options;
+    options.cpus = {cpus[t]};
+    options.name = "sweep-" + std::to_string(t);
+    options.numa_local = true;
+    options.arena_size = words * sizeof(std::uint64_t);
+    workers.emplace_back(std::move(options), [&, t] {
+      auto* data = static_cast<std::uint64_t*>(affinity::this_thread_arena()->allocate(words * sizeof(std::uint64_t)));
+      fill({data, words});
+      sweep({data, words}, passes, results[t]);
+    });
+  }
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers[t].join();
+    results[t].cpu = workers[t].cpu_time();
+  }
+  report("pinned", results, words * sizeof(std::uint64_t), passes);
+}
+
+// 构造函数的约束和基本功能
+void check_affinity_thread() {
+  static_assert(!std::is_copy_constructible_v<AffinityThread>);
+  static_assert(std::is_nothrow_move_constructible_v<AffinityThread>);
+
+  ThreadOptions options;
+  options.cpus = {allowed_cpus().front()};
+  options.name = "affinity-check-with-a-long-name";
+  options.stack_size = 256 * 1024;
+  options.arena_size = 4096;
+  int cpu = -1;
+  std::string name;
+  bool has_arena = false;
+  AffinityThread t1(options, [&](int x) {
+    char buf[16]{};
+    ::pthread_getname_np(::pthread_self(), buf, sizeof(buf));
+    name = buf;
+    cpu = affinity::current_cpu();
+    has_arena = affinity::this_thread_arena() != nullptr && affinity::this_thread_arena()->create<int>(x) != nullptr;
+  }, 42);
+  AffinityThread t2(std::move(t1));  // 移动构造函数, 而不是转发构造函数
+  assert(!t1.joinable() && t2.joinable());
+  t2.join();
+  assert(cpu == options.cpus.front());
+  assert(name == "affinity-check-");  // 截断为 15 个字符
+  assert(has_arena);
+  assert(t2.cpu_time().count() >= 0);
+}
+
+int main(int argc, char** argv) {
+  check_affinity_thread();
+
+  const auto hw = std::max(1U, std::thread::hardware_concurrency());
+  const std::size_t threads = utils::arg_or(argc, argv, 1, hw);
+  const std::size_t mb = utils::arg_or(argc, argv, 2, 32);
+  const std::size_t passes = utils::arg_or(argc, argv, 3, 8);
+  const std::size_t words = mb * 1024 * 1024 / sizeof(std::uint64_t);
+  std::println("threads: {}, {} MB per thread, {} passes, numa nodes: {}", threads, mb, passes,
+      affinity::numa_node_count());
+  run_unpinned(threads, words, passes);
+  run_pinned(threads, words, passes);
+  return 0;
+}
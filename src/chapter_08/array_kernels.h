@@ -0,0 +1,331 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 18:20:16
+# Desc   : 按数组大小选择实现的 std::array 计算内核: sum / dot / copy / transform
+########################################################################
+*/
+/*
+和 8.3 的 Helper<SZ, bool = is_prime_cpp14(SZ)> 一样, 用编译期的 SZ 通过偏特化选择实现:
+1. SZ <= 16(kUnrollLimit): 折叠表达式完全展开, 没有循环
+2. SZ <= 512(kBlockedThreshold): 向量主循环, 尾部不足一个向量时用补零的部分加载/存储(相当于掩码)
+3. 更大的 SZ: 分块, 每块内用 4 个独立的向量累加器打破依赖链, 块之间再累加
+向量用 GCC/Clang 的 vector_size 扩展, 开启 AVX 时宽度 32 字节, 否则 16 字节
+注意: 浮点数 sum / dot 的累加顺序和逐个相加不同, 结果可能有舍入误差
+不能向量化的类型(std::complex、自定义的数值类型等)在 2 / 3 中退化为多个累加器的标量循环, copy 用 std::copy_n,
+所以按大小选择实现不会改变接受的元素类型
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace array_kernels {
+
+inline constexpr std::size_t kUnrollLimit = 16;
+inline constexpr std::size_t kBlockedThreshold = 512;
+inline constexpr std::size_t kBlockSize = 1024;  // 分块时每块的元素个数
+inline constexpr std::size_t kAccumulators = 4;
+#if defined(__AVX__)
+inline constexpr std::size_t kVectorBytes = 32;
+#else
+inline constexpr std::size_t kVectorBytes = 16;  // SSE2 / NEON
+#endif
+
+enum class KernelKind { kUnrolled, kSimd, kBlocked };
+
+constexpr KernelKind kernel_kind(std::size_t sz) {
+  if (sz <= kUnrollLimit) {
+    return KernelKind::kUnrolled;
+  }
+  return sz <= kBlockedThreshold ? KernelKind::kSimd : KernelKind::kBlocked;
+}
+
+namespace detail {
+
+template <typename T>
+concept Vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+// vector_size 不能直接用于别名模板的依赖类型, 放在类模板的 typedef 中
+template <typename T>
+struct Vector {
+  typedef T type __attribute__((vector_size(kVectorBytes)));
+};  // struct Vector
+template <typename T>
+using vec_t = typename Vector<T>::type;
+
+// 比向量寄存器还宽的类型(只会出现在 transform 中)按 1 个元素一组
+template <typename T>
+inline constexpr std::size_t kLanes = std::max<std::size_t>(1, kVectorBytes / sizeof(T));
+
+template <typename T>
+vec_t<T> load(const T* p) {
+  vec_t<T> v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+// 只加载前 N 个元素, 其余为 0, 对 sum / dot 没有影响
+template <std::size_t N, typename T>
+vec_t<T> load_partial(const T* p) {
+  vec_t<T> v{};
+  std::memcpy(&v, p, N * sizeof(T));
+  return v;
+}
+template <typename T>
+void store(T* p, const vec_t<T>& v) {
+  std::memcpy(p, &v, sizeof(v));
+}
+template <std::size_t N, typename T>
+void store_partial(T* p, const vec_t<T>& v) {
+  std::memcpy(p, &v, N * sizeof(T));
+}
+template <typename T>
+T horizontal_sum(const vec_t<T>& v) {
+  T result{};
+  for (std::size_t i = 0; i < kLanes<T>; ++i) {
+    result += v[i];
+  }
+  return result;
+}
+
+// 对 [a, a + N) 求和(kDot 为 true 时求 a 和 b 的内积), 使用 A 个向量累加器
+template <std::size_t N, std::size_t A, bool kDot, typename T>
+T simd_reduce(const T* a, const T* b) {
+  constexpr std::size_t L = kLanes<T>;
+  vec_t<T> acc[A]{};
+  std::size_t i = 0;
+  for (; i + L * A <= N; i += L * A) {
+    for (std::size_t k = 0; k < A; ++k) {
+      auto v = load(a + i + k * L);
+      if constexpr (kDot) {
+        v *= load(b + i + k * L);
+      }
+      acc[k] += v;
+    }
+  }
+  for (; i + L <= N; i += L) {
+    auto v = load(a + i);
+    if constexpr (kDot) {
+      v *= load(b + i);
+    }
+    acc[0] += v;
+  }
+  if constexpr (N % L != 0) {
+    auto v = load_partial<N % L>(a + N - N % L);
+    if constexpr (kDot) {
+      v *= load_partial<N % L>(b + N - N % L);
+    }
+    acc[0] += v;
+  }
+  for (std::size_t k = 1; k < A; ++k) {
+    acc[0] += acc[k];
+  }
+  return horizontal_sum<T>(acc[0]);
+}
+
+// 不能向量化的类型: 标量循环, 使用 A 个独立的累加器
+template <std::size_t N, std::size_t A, bool kDot, typename T>
+T scalar_reduce(const T* a, const T* b) {
+  constexpr std::size_t kMain = N - N % A;
+  T acc[A]{};
+  for (std::size_t i = 0; i < kMain; i += A) {
+    for (std::size_t k = 0; k < A; ++k) {
+      if constexpr (kDot) {
+        acc[k] += a[i + k] * b[i + k];
+      } else {
+        acc[k] += a[i + k];
+      }
+    }
+  }
+  for (std::size_t i = kMain; i < N; ++i) {
+    if constexpr (kDot) {
+      acc[0] += a[i] * b[i];
+    } else {
+      acc[0] += a[i];
+    }
+  }
+  for (std::size_t k = 1; k < A; ++k) {
+    acc[0] += acc[k];
+  }
+  return acc[0];
+}
+
+template <std::size_t N, typename T>
+void simd_copy(const T* src, T* dst) {
+  constexpr std::size_t L = kLanes<T>;
+  std::size_t i = 0;
+  for (; i + L <= N; i += L) {
+    store(dst + i, load(src + i));
+  }
+  if constexpr (N % L != 0) {
+    store_partial<N % L>(dst + i, load_partial<N % L>(src + i));
+  }
+}
+
+// f 是任意的可调用对象, 不一定能作用于向量, 所以按向量宽度逐元素调用, 由编译器向量化
+template <std::size_t N, std::size_t L, typename T, typename U, typename F>
+void chunked_transform(const T* src, U* dst, F& f) {
+  constexpr std::size_t kMain = N - N % L;
+  for (std::size_t i = 0; i < kMain; i += L) {
+    for (std::size_t k = 0; k < L; ++k) {
+      dst[i + k] = f(src[i + k]);
+    }
+  }
+  for (std::size_t i = kMain; i < N; ++i) {
+    dst[i] = f(src[i]);
+  }
+}
+
+}  // namespace detail
+
+// 主模板, 只声明
+template <std::size_t SZ, KernelKind = kernel_kind(SZ)>
+struct Kernel;
+
+// 完全展开
+template <std::size_t SZ>
+struct Kernel<SZ, KernelKind::kUnrolled> {
+  static constexpr KernelKind kind = KernelKind::kUnrolled;
+
+  template <typename T>
+  static constexpr T sum(const T* a) {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return (T{} + ... + a[I]);
+    }(std::make_index_sequence<SZ>{});
+  }
+  template <typename T>
+  static constexpr T dot(const T* a, const T* b) {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return (T{} + ... + (a[I] * b[I]));
+    }(std::make_index_sequence<SZ>{});
+  }
+  template <typename T>
+  static constexpr void copy(const T* src, T* dst) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      ((dst[I] = src[I]), ...);
+    }(std::make_index_sequence<SZ>{});
+  }
+  template <typename T, typename U, typename F>
+  static constexpr void transform(const T* src, U* dst, F& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      ((dst[I] = f(src[I])), ...);
+    }(std::make_index_sequence<SZ>{});
+  }
+};  // struct Kernel<SZ, KernelKind::kUnrolled>
+
+// 向量主循环 + 尾部部分加载
+template <std::size_t SZ>
+struct Kernel<SZ, KernelKind::kSimd> {
+  static constexpr KernelKind kind = KernelKind::kSimd;
+
+  template <detail::Vectorizable T>
+  static T sum(const T* a) {
+    return detail::simd_reduce<SZ, 1, false>(a, a);
+  }
+  template <detail::Vectorizable T>
+  static T dot(const T* a, const T* b) {
+    return detail::simd_reduce<SZ, 1, true>(a, b);
+  }
+  template <detail::Vectorizable T>
+  static void copy(const T* src, T* dst) {
+    detail::simd_copy<SZ>(src, dst);
+  }
+  // 不能向量化的类型
+  template <typename T>
+  static T sum(const T* a) {
+    return detail::scalar_reduce<SZ, 1, false>(a, a);
+  }
+  template <typename T>
+  static T dot(const T* a, const T* b) {
+    return detail::scalar_reduce<SZ, 1, true>(a, b);
+  }
+  template <typename T>
+  static void copy(const T* src, T* dst) {
+    std::copy_n(src, SZ, dst);
+  }
+  template <typename T, typename U, typename F>
+  static void transform(const T* src, U* dst, F& f) {
+    detail::chunked_transform<SZ, detail::kLanes<U>>(src, dst, f);
+  }
+};  // struct Kernel<SZ, KernelKind::kSimd>
+
+// 分块, 每块使用多个累加器
+template <std::size_t SZ>
+struct Kernel<SZ, KernelKind::kBlocked> {
+  static constexpr KernelKind kind = KernelKind::kBlocked;
+  static constexpr std::size_t kBlocks = SZ / kBlockSize;
+  static constexpr std::size_t kTail = SZ % kBlockSize;
+
+  template <detail::Vectorizable T>
+  static T sum(const T* a) {
+    return reduce<false>(a, a);
+  }
+  template <detail::Vectorizable T>
+  static T dot(const T* a, const T* b) {
+    return reduce<true>(a, b);
+  }
+  // 大数组的拷贝受内存带宽限制, 直接交给 memcpy
+  template <detail::Vectorizable T>
+  static void copy(const T* src, T* dst) {
+    std::memcpy(dst, src, SZ * sizeof(T));
+  }
+  // 不能向量化的类型
+  template <typename T>
+  static T sum(const T* a) {
+    return detail::scalar_reduce<SZ, kAccumulators, false>(a, a);
+  }
+  template <typename T>
+  static T dot(const T* a, const T* b) {
+    return detail::scalar_reduce<SZ, kAccumulators, true>(a, b);
+  }
+  template <typename T>
+  static void copy(const T* src, T* dst) {
+    std::copy_n(src, SZ, dst);
+  }
+  template <typename T, typename U, typename F>
+  static void transform(const T* src, U* dst, F& f) {
+    detail::chunked_transform<SZ, detail::kLanes<U> * kAccumulators>(src, dst, f);
+  }
+
+private:
+  template <bool kDot, detail::Vectorizable T>
+  static T reduce(const T* a, const T* b) {
+    T total{};
+    for (std::size_t block = 0; block < kBlocks; ++block) {
+      const std::size_t offset = block * kBlockSize;
+      total += detail::simd_reduce<kBlockSize, kAccumulators, kDot>(a + offset, b + offset);
+    }
+    if constexpr (kTail != 0) {
+      total += detail::simd_reduce<kTail, kAccumulators, kDot>(a + kBlocks * kBlockSize, b + kBlocks * kBlockSize);
+    }
+    return total;
+  }
+};  // struct Kernel<SZ, KernelKind::kBlocked>
+
+template <typename T, std::size_t SZ>
+constexpr T sum(const std::array<T, SZ>& a) {
+  return Kernel<SZ>::sum(a.data());
+}
+template <typename T, std::size_t SZ>
+constexpr T dot(const std::array<T, SZ>& a, const std::array<T, SZ>& b) {
+  return Kernel<SZ>::dot(a.data(), b.data());
+}
+template <typename T, std::size_t SZ>
+constexpr void copy(const std::array<T, SZ>& src, std::array<T, SZ>& dst) {
+  Kernel<SZ>::copy(src.data(), dst.data());
+}
+template <typename T, typename U, std::size_t SZ, typename F>
+constexpr void transform(const std::array<T, SZ>& src, std::array<U, SZ>& dst, F f) {
+  Kernel<SZ>::transform(src.data(), dst.data(), f);
+}
+
+}  // namespace array_kernels
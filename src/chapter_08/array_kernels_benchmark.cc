@@ -0,0 +1,121 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 18:47:05
+# Desc   : array_kernels 与普通循环在不同数组大小下的对比
+########################################################################
+*/
+/*
+用法: chapter_08_array_kernels_benchmark [elements]
+每个大小重复 elements / SZ 次, 结果是每个元素的耗时
+1. SZ <= 16 完全展开, 17 ~ 512 向量化, 更大的分块
+2. 普通循环求 float 的和/内积时, 没有 -ffast-math 编译器不能重排加法, 所以不会向量化
+*/
+
+#include <array>
+#include <format>
+#include <print>
+
+#include "utils/benchmark.h"
+
+#include "array_kernels.h"
+
+constexpr auto kTransform = [](float x) { return x * 1.5F + 1.0F; };
+
+template <std::size_t SZ>
+void bench_size(std::size_t elements) {
+  const std::size_t repeats = std::max<std::size_t>(1, elements / SZ);
+  const std::size_t ops = repeats * SZ;
+  std::array<float, SZ> a{};
+  std::array<float, SZ> b{};
+  std::array<float, SZ> c{};
+  for (std::size_t i = 0; i < SZ; ++i) {
+    a[i] = static_cast<float>(i % 13) * 0.5F;
+    b[i] = static_cast<float>(i % 7) * 0.25F;
+  }
+  const auto kind = array_kernels::Kernel<SZ>::kind;
+  const char* kind_name = kind == array_kernels::KernelKind::kUnrolled ? "unrolled"
+      : kind == array_kernels::KernelKind::kSimd ? "simd" : "blocked";
+  std::println("SZ = {} ({})", SZ, kind_name);
+
+  utils::run_benchmark("  sum, loop", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      float s = 0;
+      for (float x : a) {
+        s += x;
+      }
+      utils::do_not_optimize(s);
+    }
+  });
+  utils::run_benchmark("  sum, kernel", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      utils::do_not_optimize(array_kernels::sum(a));
+    }
+  });
+  utils::run_benchmark("  dot, loop", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      float s = 0;
+      for (std::size_t i = 0; i < SZ; ++i) {
+        s += a[i] * b[i];
+      }
+      utils::do_not_optimize(s);
+    }
+  });
+  utils::run_benchmark("  dot, kernel", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      utils::do_not_optimize(array_kernels::dot(a, b));
+    }
+  });
+  utils::run_benchmark("  copy, loop", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      for (std::size_t i = 0; i < SZ; ++i) {
+        c[i] = a[i];
+      }
+      utils::do_not_optimize(c);
+    }
+  });
+  utils::run_benchmark("  copy, kernel", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      array_kernels::copy(a, c);
+      utils::do_not_optimize(c);
+    }
+  });
+  utils::run_benchmark("  transform, loop", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      for (std::size_t i = 0; i < SZ; ++i) {
+        c[i] = kTransform(a[i]);
+      }
+      utils::do_not_optimize(c);
+    }
+  });
+  utils::run_benchmark("  transform, kernel", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(a);
+      array_kernels::transform(a, c, kTransform);
+      utils::do_not_optimize(c);
+    }
+  });
+}
+
+template <std::size_t... SZ>
+void bench_sizes(std::size_t elements) {
+  (bench_size<SZ>(elements), ...);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t elements = utils::arg_or(argc, argv, 1, 10'000'000);
+  bench_sizes<1, 2, 4, 8, 15, 16, 17, 31, 64, 100, 256, 512, 513, 1000, 1024, 2048, 4096>(elements);
+  return 0;
+}
@@ -11,10 +11,17 @@
 ########################################################################
 */
 
+#include <cassert>
+#include <complex>
 #include <print>
+#include <string>
 #include <type_traits>
 #include "cpp_utils/util.h"
 
+#include "array_kernels.h"
+#include "prime.h"
+#include "prime_sieve.h"
+
 
 // 8.1 模板元编程
 template <unsigned p, unsigned d>
@@ -86,6 +93,29 @@ void run_is_prime() {
 }
 const bool b3 = is_prime_cpp14(9);  // 在编译期求值
 
+// IsPrime<p> 的递归深度是 p / 2, is_prime_cpp14(p) 需要 O(p) 次循环, 都只能用于很小的 p
+// Miller-Rabin 对任意 64 位整数都可以在编译期求值, 见 prime.h
+void run_miller_rabin() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  static_assert(!prime::IsPrimeMR<9>::value, "9 is not a prime number");
+  static_assert(prime::IsPrimeMR<11>::value, "11 is a prime number");
+  static_assert(prime::is_prime_miller_rabin(2147483647), "2^31 - 1 is a prime number");
+  static_assert(prime::is_prime_miller_rabin(18446744073709551557ULL), "the largest 64-bit prime");
+  static_assert(!prime::is_prime_miller_rabin(3215031751), "strong pseudoprime to bases 2, 3, 5, 7");
+
+  // 运行期用分段筛法生成素数表
+  prime::PrimeSieve sieve(100);
+  std::print("primes <= 100:");
+  sieve.for_each_prime([](std::uint64_t p) { std::print(" {}", p); });
+  std::println();
+  assert(sieve.count() == 25);
+  assert(prime::count_primes(1'000'000) == 78498);
+  for (std::uint64_t n = 0; n <= sieve.limit(); ++n) {
+    assert(sieve.is_prime(n) == prime::is_prime_miller_rabin(n));
+  }
+  std::println();
+}
+
 // 8.3 偏特化的执行路径选择
 // 主模板
 template <int SZ, bool = is_prime_cpp14(SZ)>
@@ -161,6 +191,76 @@ void run_template_specialization_selection_2() {
   std::println();
 }
 
+// 同样的方法用于真正的计算内核: 按 SZ 选择完全展开、向量化或分块的实现, 见 array_kernels.h
+template <std::size_t SZ>
+void check_array_kernels() {
+  std::array<int, SZ> a{};
+  std::array<int, SZ> b{};
+  for (std::size_t i = 0; i < SZ; ++i) {
+    a[i] = static_cast<int>(i);
+    b[i] = static_cast<int>(i % 7);
+  }
+  int expected_dot = 0;
+  for (std::size_t i = 0; i < SZ; ++i) {
+    expected_dot += a[i] * b[i];
+  }
+  assert(array_kernels::sum(a) == static_cast<int>(SZ * (SZ - 1) / 2));
+  assert(array_kernels::dot(a, b) == expected_dot);
+  std::array<int, SZ> c{};
+  array_kernels::copy(a, c);
+  assert(c == a);
+  std::array<long, SZ> d{};
+  array_kernels::transform(a, d, [](int x) { return 2L * x; });
+  for (std::size_t i = 0; i < SZ; ++i) {
+    assert(d[i] == 2L * a[i]);
+  }
+
+  // 不能向量化的元素类型, 以及比向量寄存器还宽的 transform 目标类型, 在每种 SZ 下都能使用
+  std::array<std::complex<double>, SZ> z{};
+  for (std::size_t i = 0; i < SZ; ++i) {
+    z[i] = {static_cast<double>(i), 1.0};
+  }
+  assert(array_kernels::sum(z) == std::complex<double>(static_cast<double>(SZ * (SZ - 1) / 2), static_cast<double>(SZ)));
+  std::complex<double> expected_z{};
+  for (std::size_t i = 0; i < SZ; ++i) {
+    expected_z += z[i] * z[i];
+  }
+  assert(array_kernels::dot(z, z) == expected_z);
+  std::array<std::complex<double>, SZ> w{};
+  array_kernels::copy(z, w);
+  assert(w == z);
+  std::array<std::string, SZ> s{};
+  array_kernels::transform(a, s, [](int x) { return std::to_string(x); });
+  for (std::size_t i = 0; i < SZ; ++i) {
+    assert(s[i] == std::to_string(a[i]));
+  }
+}
+
+void run_array_kernels() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  using array_kernels::Kernel;
+  using array_kernels::KernelKind;
+  static_assert(Kernel<16>::kind == KernelKind::kUnrolled);
+  static_assert(Kernel<17>::kind == KernelKind::kSimd);
+  static_assert(Kernel<4096>::kind == KernelKind::kBlocked);
+  static_assert(array_kernels::sum(std::array{1, 2, 3}) == 6);  // 完全展开的版本是 constexpr 的
+
+  check_array_kernels<0>();
+  check_array_kernels<5>();
+  check_array_kernels<16>();
+  check_array_kernels<17>();
+  check_array_kernels<100>();
+  check_array_kernels<512>();
+  check_array_kernels<513>();
+  check_array_kernels<2500>();
+  std::array<double, 100> values{};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<double>(i + 1);
+  }
+  std::println("sum of 1..100 = {}", array_kernels::sum(values));
+  std::println();
+}
+
 // 函数模板不支持偏特化, 解决办法
 // 1. 带有静态函数的类: 比如上面的 Helper::print，其实就是通过类中包含静态函数，利用类的偏特化来实现函数的偏特化
 // 2. 使用 std::enable_if<>
@@ -343,8 +443,10 @@ void run_foo() {
 
 int main() {
   run_is_prime();
+  run_miller_rabin();
   run_template_specialization_selection();
   run_template_specialization_selection_2();
+  run_array_kernels();
   run_function_specialization();
   run_SFINAE();
   run_SFINAE_2();
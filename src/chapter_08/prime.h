@@ -0,0 +1,89 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 16:30:02
+# Desc   : constexpr 确定性 Miller-Rabin 素性测试
+########################################################################
+*/
+/*
+8.1 的 IsPrime<p> 和 8.2 的 is_prime_cpp14(p) 都是试除法
+1. IsPrime<p> 的递归深度是 p / 2, 很快就会超过编译器的模板实例化深度
+2. is_prime_cpp14(p) 需要 O(p) 次循环, 很快就会超过 constexpr 的求值步数限制
+Miller-Rabin 只需要 O(k * log(n)) 次乘法
+对于 64 位整数，使用前 12 个素数 {2, 3, ..., 37} 作为底数时结果是确定的(没有伪素数)
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace prime {
+
+// (a * b) % m, 用 128 位整数避免溢出
+constexpr std::uint64_t mul_mod(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+  return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+}
+
+constexpr std::uint64_t pow_mod(std::uint64_t base, std::uint64_t exp, std::uint64_t m) {
+  std::uint64_t result = 1;
+  base %= m;
+  while (exp > 0) {
+    if (exp & 1) {
+      result = mul_mod(result, base, m);
+    }
+    base = mul_mod(base, base, m);
+    exp >>= 1;
+  }
+  return result;
+}
+
+inline constexpr std::array<std::uint64_t, 12> kMillerRabinBases{2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+constexpr bool is_prime_miller_rabin(std::uint64_t n) {
+  if (n < 2) {
+    return false;
+  }
+  for (auto p : kMillerRabinBases) {  // 小素数及其倍数
+    if (n % p == 0) {
+      return n == p;
+    }
+  }
+  // n - 1 = d * 2^s, d 为奇数
+  std::uint64_t d = n - 1;
+  unsigned s = 0;
+  while ((d & 1) == 0) {
+    d >>= 1;
+    ++s;
+  }
+  for (auto a : kMillerRabinBases) {
+    std::uint64_t x = pow_mod(a, d, n);
+    if (x == 1 || x == n - 1) {
+      continue;
+    }
+    bool composite = true;
+    for (unsigned r = 1; r < s; ++r) {
+      x = mul_mod(x, x, n);
+      if (x == n - 1) {
+        composite = false;
+        break;
+      }
+    }
+    if (composite) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 和 8.1 IsPrime<p> 相同的接口
+template <std::uint64_t p>
+struct IsPrimeMR {
+  static constexpr bool value = is_prime_miller_rabin(p);
+};  // struct IsPrimeMR
+
+}  // namespace prime
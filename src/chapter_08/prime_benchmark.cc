@@ -0,0 +1,105 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 17:32:14
+# Desc   : 分段筛法、Miller-Rabin 与试除法的运行期对比
+########################################################################
+*/
+/*
+用法: chapter_08_prime_benchmark [limit] [threads]
+默认 limit = 10^8, 统计 10^10 以内的素数: chapter_08_prime_benchmark 10000000000
+(结果应为 455052511, 整表需要约 625MB, 所以超过 10^9 时只统计个数, 不保存整表)
+
+编译期的对比见 prime_compile_time.cc
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <optional>
+#include <print>
+#include <thread>
+
+#include "utils/benchmark.h"
+
+#include "prime.h"
+#include "prime_sieve.h"
+
+// 和 8.2 的 is_prime_cpp14 相同, 只是改成了 64 位, 并且只试除到 sqrt(p)
+constexpr bool is_prime_trial_division(std::uint64_t p) {
+  for (std::uint64_t d = 2; d * d <= p; ++d) {
+    if (p % d == 0) {
+      return false;
+    }
+  }
+  return p > 1;
+}
+
+int main(int argc, char** argv) {
+  const std::uint64_t limit = utils::arg_or(argc, argv, 1, 100'000'000);
+  const auto hw = std::max(1U, std::thread::hardware_concurrency());
+  const auto threads = static_cast<unsigned>(utils::arg_or(argc, argv, 2, hw));
+  std::println("limit: {}, threads: {}", limit, threads);
+
+  std::uint64_t single = 0;
+  std::uint64_t multi = 0;
+  utils::run_benchmark("count_primes, 1 thread, per integer", limit, [&] {
+    single = prime::count_primes(limit, 1);
+  }, 1);
+  utils::run_benchmark(std::format("count_primes, {} threads, per integer", threads), limit, [&] {
+    multi = prime::count_primes(limit, threads);
+  }, 1);
+  assert(single == multi);
+  std::println("pi({}) = {}", limit, multi);
+
+  constexpr std::uint64_t kTableLimit = 1'000'000'000;
+  const std::uint64_t table_limit = std::min(limit, kTableLimit);
+  std::optional<prime::PrimeSieve> sieve;
+  utils::run_benchmark(std::format("PrimeSieve({}) table, per integer", table_limit), table_limit, [&] {
+    sieve.emplace(table_limit, threads);
+  }, 1);
+  std::println("table memory: {} bytes, count: {}", sieve->memory_usage(), sieve->count());
+
+  // 单个数的测试: 表的最后 kQueries 个奇数
+  constexpr std::uint64_t kQueries = 100'000;
+  const std::uint64_t first = table_limit > 2 * kQueries ? (table_limit - 2 * kQueries) | 1 : 3;
+  std::uint64_t found_table = 0;
+  std::uint64_t found_mr = 0;
+  std::uint64_t found_trial = 0;
+  utils::run_benchmark("PrimeSieve::is_prime", kQueries, [&] {
+    found_table = 0;
+    for (std::uint64_t n = first; n < first + 2 * kQueries; n += 2) {
+      found_table += sieve->is_prime(n);
+    }
+  });
+  utils::run_benchmark("is_prime_miller_rabin", kQueries, [&] {
+    found_mr = 0;
+    for (std::uint64_t n = first; n < first + 2 * kQueries; n += 2) {
+      found_mr += prime::is_prime_miller_rabin(n);
+    }
+  });
+  utils::run_benchmark("trial division", kQueries, [&] {
+    found_trial = 0;
+    for (std::uint64_t n = first; n < first + 2 * kQueries; n += 2) {
+      found_trial += is_prime_trial_division(n);
+    }
+  }, 1);
+  assert(found_table == found_mr && found_mr == found_trial);
+
+  // Miller-Rabin 对 64 位的大数也适用
+  constexpr std::uint64_t kLargest64BitPrime = 18446744073709551557ULL;
+  static_assert(prime::is_prime_miller_rabin(kLargest64BitPrime));
+  utils::run_benchmark("is_prime_miller_rabin near 2^64", kQueries, [&] {
+    std::uint64_t found = 0;
+    for (std::uint64_t n = kLargest64BitPrime - 2 * kQueries; n <= kLargest64BitPrime; n += 2) {
+      found += prime::is_prime_miller_rabin(n);
+    }
+    utils::do_not_optimize(found);
+  });
+  return 0;
+}
@@ -0,0 +1,70 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 17:51:40
+# Desc   : 编译期素性测试的编译时间对比
+########################################################################
+*/
+/*
+同一个文件编译成两个目标:
+1. chapter_08_prime_compile_time_template: 使用 8.1 的递归模板 IsPrime<p>
+2. chapter_08_prime_compile_time_miller_rabin: 使用 prime::IsPrimeMR<p>
+对比:
+  time make chapter_08_prime_compile_time_template
+  time make chapter_08_prime_compile_time_miller_rabin
+IsPrime<p> 的递归深度是 p / 2, 所以这里只测试到 kMax, 再大就会超过默认的模板实例化深度
+而 IsPrimeMR 可以直接用于 64 位整数
+*/
+
+#include <cstdint>
+#include <utility>
+
+#include "prime.h"
+
+#ifdef PRIME_COMPILE_TIME_TEMPLATE
+// 和 8.1 相同, 只是 IsPrime<2> / IsPrime<3> 特化为正确的 true
+template <unsigned p, unsigned d>
+struct DoIsPrime {
+  static constexpr bool value = (p % d != 0) && DoIsPrime<p, d - 1>::value;
+};  // struct DoIsPrime
+template <unsigned p>
+struct DoIsPrime<p, 2> {
+  static constexpr bool value = (p % 2 != 0);
+};  // struct DoIsPrime<p, 2>
+template <unsigned p>
+struct IsPrime {
+  static constexpr bool value = DoIsPrime<p, p / 2>::value;
+};  // struct IsPrime
+template <>
+struct IsPrime<2> {
+  static constexpr bool value = true;
+};  // struct IsPrime<2>
+template <>
+struct IsPrime<3> {
+  static constexpr bool value = true;
+};  // struct IsPrime<3>
+template <unsigned p>
+constexpr bool is_prime_v = IsPrime<p>::value;
+#else
+template <unsigned p>
+constexpr bool is_prime_v = prime::IsPrimeMR<p>::value;
+#endif
+
+constexpr unsigned kMax = 600;
+
+template <unsigned... Ps>
+constexpr unsigned count_primes(std::integer_sequence<unsigned, Ps...>) {
+  return (0U + ... + (is_prime_v<Ps + 2> ? 1U : 0U));
+}
+
+// pi(601) = 110
+static_assert(count_primes(std::make_integer_sequence<unsigned, kMax>{}) == 110);
+
+unsigned prime_count_below_kmax() {
+  return count_primes(std::make_integer_sequence<unsigned, kMax>{});
+}
@@ -0,0 +1,165 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 17:05:37
+# Desc   :
+########################################################################
+*/
+
+#include "prime_sieve.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+namespace prime {
+
+namespace {
+
+// 每段 64KB, 也就是 2^19 个奇数
+constexpr std::uint64_t kSegmentWords = 8 * 1024;
+constexpr std::uint64_t kSegmentBits = kSegmentWords * 64;
+
+std::uint64_t isqrt(std::uint64_t n) {
+  auto r = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+  while (r * r > n) {
+    --r;
+  }
+  while ((r + 1) * (r + 1) <= n) {
+    ++r;
+  }
+  return r;
+}
+
+// 不超过 sqrt(limit) 的奇素数, 用普通的筛法
+std::vector<std::uint64_t> base_primes(std::uint64_t limit) {
+  const std::uint64_t root = isqrt(limit);
+  std::vector<bool> composite(root + 1, false);
+  std::vector<std::uint64_t> primes;
+  for (std::uint64_t i = 3; i <= root; i += 2) {
+    if (composite[i]) {
+      continue;
+    }
+    primes.push_back(i);
+    for (std::uint64_t j = i * i; j <= root; j += 2 * i) {
+      composite[j] = true;
+    }
+  }
+  return primes;
+}
+
+// 筛一段: words 的第 b 位表示奇数 2 * (first_bit + b) + 1
+void sieve_segment(std::uint64_t* words, std::uint64_t first_bit, std::uint64_t bits,
+    const std::vector<std::uint64_t>& primes) {
+  std::fill_n(words, (bits + 63) / 64, 0);
+  const std::uint64_t low = 2 * first_bit + 1;
+  const std::uint64_t high = 2 * (first_bit + bits) - 1;
+  for (std::uint64_t p : primes) {
+    if (p * p > high) {
+      break;
+    }
+    std::uint64_t start = p * p;
+    if (start < low) {
+      start = (low + p - 1) / p * p;
+      if ((start & 1) == 0) {
+        start += p;
+      }
+    }
+    // 奇数之间相差 2p, 对应的位相差 p
+    for (std::uint64_t b = (start - 1) / 2 - first_bit; b < bits; b += p) {
+      words[b / 64] |= std::uint64_t{1} << (b % 64);
+    }
+  }
+}
+
+// 前 bits 位中 0 的个数
+std::uint64_t count_zero_bits(const std::uint64_t* words, std::uint64_t bits) {
+  std::uint64_t zeros = 0;
+  const std::uint64_t full = bits / 64;
+  for (std::uint64_t i = 0; i < full; ++i) {
+    zeros += 64 - std::popcount(words[i]);
+  }
+  if (std::uint64_t rest = bits % 64; rest != 0) {
+    zeros += rest - std::popcount(words[full] & ((std::uint64_t{1} << rest) - 1));
+  }
+  return zeros;
+}
+
+// 第 i 位表示 2i+1, 2i+1 <= limit
+std::uint64_t total_bits(std::uint64_t limit) {
+  return (limit + 1) / 2;
+}
+
+// 多个线程从原子计数器领取段, f(worker, first_bit, bits)
+template <typename F>
+void for_each_segment(std::uint64_t bits, unsigned threads, F&& f) {
+  const std::uint64_t segments = (bits + kSegmentBits - 1) / kSegmentBits;
+  threads = static_cast<unsigned>(std::clamp<std::uint64_t>(threads, 1, std::max<std::uint64_t>(segments, 1)));
+  std::atomic<std::uint64_t> next{0};
+  auto work = [&](unsigned worker) {
+    for (std::uint64_t s = next.fetch_add(1, std::memory_order_relaxed); s < segments;
+        s = next.fetch_add(1, std::memory_order_relaxed)) {
+      const std::uint64_t first = s * kSegmentBits;
+      f(worker, first, std::min(kSegmentBits, bits - first));
+    }
+  };
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; ++t) {
+    workers.emplace_back(work, t);
+  }
+  work(0);
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+}  // namespace
+
+PrimeSieve::PrimeSieve(std::uint64_t limit, unsigned threads)
+    : limit_(limit), composite_((total_bits(limit) + 63) / 64) {
+  if (composite_.empty()) {
+    return;
+  }
+  const auto primes = base_primes(limit);
+  const std::uint64_t bits = total_bits(limit);
+  for_each_segment(bits, threads, [&](unsigned, std::uint64_t first, std::uint64_t n) {
+    sieve_segment(composite_.data() + first / 64, first, n, primes);
+  });
+  composite_[0] |= 1;  // 1 不是素数
+}
+
+std::uint64_t PrimeSieve::count() const {
+  if (limit_ < 2) {
+    return 0;
+  }
+  return count_zero_bits(composite_.data(), total_bits(limit_)) + 1;  // 加上 2
+}
+
+std::uint64_t count_primes(std::uint64_t limit, unsigned threads) {
+  if (limit < 2) {
+    return 0;
+  }
+  const auto primes = base_primes(limit);
+  const std::uint64_t bits = total_bits(limit);
+  threads = std::max(threads, 1U);
+  std::vector<std::vector<std::uint64_t>> segments(threads, std::vector<std::uint64_t>(kSegmentWords));
+  std::vector<std::uint64_t> counts(threads, 0);
+  for_each_segment(bits, threads, [&](unsigned worker, std::uint64_t first, std::uint64_t n) {
+    sieve_segment(segments[worker].data(), first, n, primes);
+    counts[worker] += count_zero_bits(segments[worker].data(), n);
+  });
+  std::uint64_t total = 0;
+  for (auto c : counts) {
+    total += c;
+  }
+  // 第 0 位表示的 1 没有被标记为合数, 正好抵消没有统计的 2
+  return total;
+}
+
+}  // namespace prime
@@ -0,0 +1,69 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 16:48:55
+# Desc   : 多线程分段埃拉托斯特尼筛法, 只保存奇数, 按位压缩
+########################################################################
+*/
+/*
+1. 第 i 位表示奇数 2i+1, 每个字节保存 16 个整数, 1e10 以内的整表约 625MB
+2. 按段筛, 每段的大小接近 L2 cache, 段按原子计数器分给各个线程
+3. 段的边界按 64 位对齐, 不同线程不会写同一个 uint64_t
+4. PrimeSieve 保存整张表, 可以 O(1) 查询; count_primes 只统计个数, 每个线程只需要一个段的内存
+*/
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace prime {
+
+class PrimeSieve {
+public:
+  // 筛出 [0, limit] 内的所有素数
+  explicit PrimeSieve(std::uint64_t limit, unsigned threads = std::thread::hardware_concurrency());
+
+  bool is_prime(std::uint64_t n) const {
+    if (n > limit_) {
+      return false;
+    }
+    if (n < 3) {
+      return n == 2;
+    }
+    if ((n & 1) == 0) {
+      return false;
+    }
+    std::uint64_t i = n / 2;
+    return ((composite_[i / 64] >> (i % 64)) & 1) == 0;
+  }
+  std::uint64_t limit() const { return limit_; }
+  std::uint64_t count() const;
+  std::size_t memory_usage() const { return composite_.size() * sizeof(std::uint64_t); }
+
+  template <typename F>
+  void for_each_prime(F&& f) const {
+    if (limit_ >= 2) {
+      f(std::uint64_t{2});
+    }
+    for (std::uint64_t n = 3; n <= limit_; n += 2) {
+      if (is_prime(n)) {
+        f(n);
+      }
+    }
+  }
+
+private:
+  std::uint64_t limit_;
+  std::vector<std::uint64_t> composite_;  // 第 i 位为 1 表示 2i+1 是合数
+};  // class PrimeSieve
+
+// 统计 [0, limit] 内素数的个数, 不保存整张表
+std::uint64_t count_primes(std::uint64_t limit, unsigned threads = std::thread::hardware_concurrency());
+
+}  // namespace prime
@@ -18,7 +18,7 @@
 /*
 模板在头文件中声明后，需要在同一个头文件中进行定义，否则其他编译单元在进行编译后将出现链接错误
 当我们 #include "myfirst.h" 时，会增大本文件的大小，其增大的大小还包含 myfirst.h 中
-#include <print> 和 #include <typeinfo> 的大小
+#include <print> 和 #include "utils/type_name.h" 的大小
 这样也会增加编译所需的时间
 解决办法:
 1. 预编译头文件
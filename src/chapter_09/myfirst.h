@@ -13,7 +13,8 @@
 #pragma once
 
 #include <print>
-#include <typeinfo>
+
+#include "utils/type_name.h"
 
 // 模板声明
 template <typename T>
@@ -22,5 +23,5 @@ void print_type_of(const T&);
 // 模板实现/定义
 template <typename T>
 void print_type_of(const T&) {
-  std::println("{}", typeid(T).name());
+  std::println("{}", utils::type_name<T>());  // 编译期得到的类型名, 不需要 RTTI
 }
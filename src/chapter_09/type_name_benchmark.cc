@@ -0,0 +1,72 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 20:58:12
+# Desc   : 在热循环中输出类型名: utils::type_name<T>() 与 typeid + abi::__cxa_demangle 的对比
+########################################################################
+*/
+/*
+用法: chapter_09_type_name_benchmark [iterations]
+每次迭代把 "type=<类型名> value=<i>" 格式化到一个复用的 std::string 中(模拟写日志)
+1. utils::type_name<T>(): 编译期常量, 只有格式化的开销
+2. typeid(T).name(): 不需要 demangle, 但输出的是修饰名, 而且需要 RTTI
+3. abi::__cxa_demangle(typeid(T).name()): 每次都要解析修饰名并 malloc / free
+*/
+
+#include <cxxabi.h>
+
+#include <cstdlib>
+#include <format>
+#include <iterator>
+#include <map>
+#include <print>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "utils/benchmark.h"
+#include "utils/type_name.h"
+
+template <typename T, typename GetName>
+void bench(const char* name, std::size_t iterations, GetName get_name) {
+  std::string line;
+  utils::run_benchmark(name, iterations, [&] {
+    for (std::size_t i = 0; i < iterations; ++i) {
+      line.clear();
+      get_name([&](const char* type) {
+        std::format_to(std::back_inserter(line), "type={} value={}", type, i);
+      });
+      utils::do_not_optimize(line);
+    }
+  });
+}
+
+template <typename T>
+void bench_type(std::size_t iterations) {
+  std::println("{}", utils::type_name<T>());
+  bench<T>("  utils::type_name<T>()", iterations, [](auto&& log) {
+    log(utils::type_name<T>().data());  // 以 '\0' 结尾
+  });
+  bench<T>("  typeid(T).name()", iterations, [](auto&& log) {
+    log(typeid(T).name());
+  });
+  bench<T>("  abi::__cxa_demangle", iterations, [](auto&& log) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status);
+    log(status == 0 ? demangled : typeid(T).name());
+    std::free(demangled);
+  });
+}
+
+int main(int argc, char** argv) {
+  const std::size_t iterations = utils::arg_or(argc, argv, 1, 1'000'000);
+  bench_type<int>(iterations);
+  bench_type<std::vector<int>>(iterations);
+  bench_type<std::map<std::string, std::vector<double>>>(iterations);
+  return 0;
+}
@@ -11,8 +11,13 @@
 ########################################################################
 */
 
+#include <cassert>
 #include <iostream>
+#include <print>
 #include <string>
+#include <type_traits>
+
+#include "numeric_array.h"
 
 // 10.1 是"类模板"还是"模板类"
 /*
@@ -97,8 +102,37 @@ void run_array_in_class() {
   ad.array[0] = 1.0;
 }
 
+// 在 ArrayInClass 的基础上增加逐元素运算和归约, 见 numeric_array.h
+void run_numeric_array() {
+  using Vec = numeric::Array<double, 8>;
+  static_assert(alignof(Vec) == numeric::kCacheLine);
+  static_assert(std::is_trivially_copyable_v<Vec>);
+  Vec a{}, b{}, c{}, d{};
+  for (std::size_t i = 0; i < Vec::size; ++i) {
+    a[i] = static_cast<double>(i);
+    b[i] = 2.0;
+    c[i] = static_cast<double>(i) + 1.0;
+    d[i] = 1.0;
+  }
+  // b * c - d 的类型是表达式, 而不是 Array, 直到赋值给 r 时才求值
+  auto expr = a + b * c - d;
+  static_assert(!std::is_same_v<decltype(expr), Vec>);
+  Vec r = expr;
+  for (std::size_t i = 0; i < Vec::size; ++i) {
+    assert(r[i] == a[i] + b[i] * c[i] - d[i]);
+  }
+  r = -r * 0.5 + 1.0;
+  r += a;
+  assert(numeric::sum(a) == 28.0);
+  assert(numeric::dot(a, b) == 56.0);
+  assert(numeric::min(a - 3.0) == -3.0);
+  assert(numeric::max(a * a) == 49.0);
+  std::println("sum(a + b * c - d) = {}", numeric::sum(a + b * c - d));
+}
+
 int main() {
   run_array_in_class();
+  run_numeric_array();
   return 0;
 }
 
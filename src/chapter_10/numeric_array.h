@@ -0,0 +1,267 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 21:20:44
+# Desc   : numeric::Array<T, N>: 按 cache line 对齐、支持表达式模板的定长数值数组
+########################################################################
+*/
+/*
+10.5 的 ArrayInClass<T, N> 只有一个 T array[N] 成员, 这里在它的基础上增加运算
+1. array 按 cache line(64 字节)对齐, 仍然是 public 成员, 可以像 ArrayInClass 一样直接访问
+2. a + b * c - d 不会立即计算, 而是返回一个表达式对象 BinaryExpr<Sub, BinaryExpr<Add, ...>, Array>
+   赋值给 Array(或者调用 sum 等归约)时才在一个循环中逐元素求值, 没有临时数组, 循环可以被向量化
+3. 表达式中的 Array 按引用保存, 中间节点按值保存, 所以表达式对象不能比参与运算的 Array 活得更久
+   auto e = a + b;  // 只能在 a 和 b 有效时使用, 一般直接赋值给 Array
+4. 逐元素运算的第 i 个结果只依赖各操作数的第 i 个元素, 所以 a = a * b + a 这种自赋值是安全的
+5. 归约: sum / dot / min / max, 每条 cache line 的元素分别累加, 打破加法的依赖链, 便于向量化
+6. 操作数的长度 N 是类型的一部分, 长度不同在编译期报错
+*/
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+// 逐元素的赋值循环之间没有依赖(见上面第 4 点), 告诉编译器可以放心向量化
+#if defined(__clang__)
+#define NUMERIC_ARRAY_VECTORIZE _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define NUMERIC_ARRAY_VECTORIZE _Pragma("GCC ivdep")
+#else
+#define NUMERIC_ARRAY_VECTORIZE
+#endif
+
+namespace numeric {
+
+inline constexpr std::size_t kCacheLine = 64;
+
+template <typename T, std::size_t N>
+class Array;
+
+// 所有的表达式(包括 Array 本身)都有 value_type、size 和 operator[]
+template <typename E>
+concept Expression = requires(const E& e, std::size_t i) {
+  typename E::value_type;
+  { E::size } -> std::convertible_to<std::size_t>;
+  { e[i] } -> std::convertible_to<typename E::value_type>;
+};
+
+namespace detail {
+
+// 表达式中的 Array 按引用保存, 其他表达式(临时对象)按值保存
+template <typename E>
+struct ExprStorage {
+  using type = const E;
+};  // struct ExprStorage
+template <typename T, std::size_t N>
+struct ExprStorage<Array<T, N>> {
+  using type = const Array<T, N>&;
+};  // struct ExprStorage<Array<T, N>>
+template <typename E>
+using expr_storage_t = typename ExprStorage<E>::type;
+
+}  // namespace detail
+
+// 标量参与运算时扩展成每个元素都相同的表达式
+template <typename T, std::size_t N>
+class ScalarExpr {
+public:
+  using value_type = T;
+  static constexpr std::size_t size = N;
+
+  constexpr explicit ScalarExpr(T value) : value_(value) {}
+  constexpr T operator[](std::size_t) const { return value_; }
+
+private:
+  T value_;
+};  // class ScalarExpr
+
+template <typename Op, typename L, typename R>
+class BinaryExpr {
+public:
+  using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+  static constexpr std::size_t size = L::size;
+  static_assert(L::size == R::size, "numeric::Array: size mismatch");
+
+  constexpr BinaryExpr(const L& l, const R& r) : l_(l), r_(r) {}
+  constexpr value_type operator[](std::size_t i) const { return Op::apply(l_[i], r_[i]); }
+
+private:
+  detail::expr_storage_t<L> l_;
+  detail::expr_storage_t<R> r_;
+};  // class BinaryExpr
+
+template <typename Op, typename E>
+class UnaryExpr {
+public:
+  using value_type = typename E::value_type;
+  static constexpr std::size_t size = E::size;
+
+  constexpr explicit UnaryExpr(const E& e) : e_(e) {}
+  constexpr value_type operator[](std::size_t i) const { return Op::apply(e_[i]); }
+
+private:
+  detail::expr_storage_t<E> e_;
+};  // class UnaryExpr
+
+struct Add {
+  template <typename A, typename B>
+  static constexpr auto apply(A a, B b) { return a + b; }
+};  // struct Add
+struct Sub {
+  template <typename A, typename B>
+  static constexpr auto apply(A a, B b) { return a - b; }
+};  // struct Sub
+struct Mul {
+  template <typename A, typename B>
+  static constexpr auto apply(A a, B b) { return a * b; }
+};  // struct Mul
+struct Div {
+  template <typename A, typename B>
+  static constexpr auto apply(A a, B b) { return a / b; }
+};  // struct Div
+struct Neg {
+  template <typename A>
+  static constexpr auto apply(A a) { return -a; }
+};  // struct Neg
+
+template <typename T, std::size_t N>
+class Array {
+public:
+  using value_type = T;
+  static constexpr std::size_t size = N;
+
+  alignas(kCacheLine) T array[N];
+
+  // 和内置数组一样, 默认构造时不初始化元素; Array<T, N> a{}; 则全部为 0
+  Array() = default;
+  constexpr explicit Array(T value) { std::fill_n(array, N, value); }
+  template <Expression E>
+    requires(E::size == N)
+  constexpr Array(const E& e) {
+    assign(e);
+  }
+  template <Expression E>
+    requires(E::size == N)
+  constexpr Array& operator=(const E& e) {
+    assign(e);
+    return *this;
+  }
+  constexpr Array& operator=(T value) {
+    std::fill_n(array, N, value);
+    return *this;
+  }
+
+  constexpr T& operator[](std::size_t i) { return array[i]; }
+  constexpr const T& operator[](std::size_t i) const { return array[i]; }
+  constexpr T* data() { return array; }
+  constexpr const T* data() const { return array; }
+  constexpr T* begin() { return array; }
+  constexpr T* end() { return array + N; }
+  constexpr const T* begin() const { return array; }
+  constexpr const T* end() const { return array + N; }
+
+  template <typename Rhs>
+  constexpr Array& operator+=(const Rhs& rhs) { return *this = *this + rhs; }
+  template <typename Rhs>
+  constexpr Array& operator-=(const Rhs& rhs) { return *this = *this - rhs; }
+  template <typename Rhs>
+  constexpr Array& operator*=(const Rhs& rhs) { return *this = *this * rhs; }
+  template <typename Rhs>
+  constexpr Array& operator/=(const Rhs& rhs) { return *this = *this / rhs; }
+
+private:
+  // 唯一的求值循环: 整个表达式在这里逐元素计算一次
+  template <typename E>
+  constexpr void assign(const E& e) {
+    NUMERIC_ARRAY_VECTORIZE
+    for (std::size_t i = 0; i < N; ++i) {
+      array[i] = static_cast<T>(e[i]);
+    }
+  }
+};  // class Array
+
+// 运算符, 只对 Expression 启用; 标量通过 ScalarExpr 参与运算
+#define NUMERIC_ARRAY_BINARY_OPERATOR(op, Op)                                                        \
+  template <Expression L, Expression R>                                                             \
+  constexpr BinaryExpr<Op, L, R> operator op(const L& l, const R& r) {                              \
+    return {l, r};                                                                                  \
+  }                                                                                                 \
+  template <Expression L>                                                                           \
+  constexpr BinaryExpr<Op, L, ScalarExpr<typename L::value_type, L::size>> operator op(             \
+      const L& l, typename L::value_type r) {                                                       \
+    return {l, ScalarExpr<typename L::value_type, L::size>(r)};                                     \
+  }                                                                                                 \
+  template <Expression R>                                                                           \
+  constexpr BinaryExpr<Op, ScalarExpr<typename R::value_type, R::size>, R> operator op(             \
+      typename R::value_type l, const R& r) {                                                       \
+    return {ScalarExpr<typename R::value_type, R::size>(l), r};                                     \
+  }
+
+NUMERIC_ARRAY_BINARY_OPERATOR(+, Add)
+NUMERIC_ARRAY_BINARY_OPERATOR(-, Sub)
+NUMERIC_ARRAY_BINARY_OPERATOR(*, Mul)
+NUMERIC_ARRAY_BINARY_OPERATOR(/, Div)
+#undef NUMERIC_ARRAY_BINARY_OPERATOR
+
+template <Expression E>
+constexpr UnaryExpr<Neg, E> operator-(const E& e) {
+  return UnaryExpr<Neg, E>(e);
+}
+
+// 归约: 每个 lane 独立累加, kLanes 个元素正好是一条 cache line
+namespace detail {
+
+template <typename E, typename Combine>
+constexpr typename E::value_type reduce(const E& e, typename E::value_type init, Combine combine) {
+  using T = typename E::value_type;
+  constexpr std::size_t N = E::size;
+  // 小数组不需要一整条 cache line 的 lane
+  constexpr std::size_t kLanes = std::clamp<std::size_t>(kCacheLine / sizeof(T), 1, std::max<std::size_t>(N, 1));
+  constexpr std::size_t kMain = N - N % kLanes;
+  T lanes[kLanes];
+  std::fill_n(lanes, kLanes, init);
+  for (std::size_t i = 0; i < kMain; i += kLanes) {
+    for (std::size_t k = 0; k < kLanes; ++k) {
+      lanes[k] = combine(lanes[k], e[i + k]);
+    }
+  }
+  for (std::size_t i = kMain; i < N; ++i) {
+    lanes[i - kMain] = combine(lanes[i - kMain], e[i]);
+  }
+  T result = init;
+  for (std::size_t k = 0; k < kLanes; ++k) {
+    result = combine(result, lanes[k]);
+  }
+  return result;
+}
+
+}  // namespace detail
+
+template <Expression E>
+constexpr typename E::value_type sum(const E& e) {
+  return detail::reduce(e, typename E::value_type{}, [](auto a, auto b) { return a + b; });
+}
+template <Expression L, Expression R>
+constexpr auto dot(const L& l, const R& r) {
+  return sum(l * r);
+}
+// N 必须大于 0
+template <Expression E>
+  requires(E::size > 0)
+constexpr typename E::value_type min(const E& e) {
+  return detail::reduce(e, e[0], [](auto a, auto b) { return b < a ? b : a; });
+}
+template <Expression E>
+  requires(E::size > 0)
+constexpr typename E::value_type max(const E& e) {
+  return detail::reduce(e, e[0], [](auto a, auto b) { return a < b ? b : a; });
+}
+
+}  // namespace numeric
@@ -0,0 +1,120 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 21:48:30
+# Desc   : 表达式模板 numeric::Array 与返回临时对象的普通运算符重载的对比
+########################################################################
+*/
+/*
+用法: chapter_10_numeric_array_benchmark [elements]
+每个 N 重复 elements / N 次, 结果是每个元素的耗时
+1. r = a + b * c - d: 普通运算符每一步都生成一个临时数组, 一共读写 3 个临时数组; 表达式模板只有一个循环
+2. sum / dot: 普通实现是逐个累加(float 的加法不能重排, 不会向量化); numeric::Array 按 lane 累加
+*/
+
+#include <cstddef>
+#include <print>
+
+#include "utils/benchmark.h"
+
+#include "numeric_array.h"
+
+// 普通的运算符重载: 每个运算都返回一个新的数组
+template <typename T, std::size_t N>
+struct NaiveArray {
+  T array[N];
+
+  friend NaiveArray operator+(const NaiveArray& a, const NaiveArray& b) {
+    NaiveArray r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r.array[i] = a.array[i] + b.array[i];
+    }
+    return r;
+  }
+  friend NaiveArray operator-(const NaiveArray& a, const NaiveArray& b) {
+    NaiveArray r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r.array[i] = a.array[i] - b.array[i];
+    }
+    return r;
+  }
+  friend NaiveArray operator*(const NaiveArray& a, const NaiveArray& b) {
+    NaiveArray r;
+    for (std::size_t i = 0; i < N; ++i) {
+      r.array[i] = a.array[i] * b.array[i];
+    }
+    return r;
+  }
+};  // struct NaiveArray
+
+template <typename T, std::size_t N>
+T naive_sum(const NaiveArray<T, N>& a) {
+  T s{};
+  for (std::size_t i = 0; i < N; ++i) {
+    s += a.array[i];
+  }
+  return s;
+}
+
+// 防止编译器把各次重复合并或者跨函数调用优化
+template <typename A>
+UTILS_NOINLINE void evaluate(A& r, const A& a, const A& b, const A& c, const A& d) {
+  r = a + b * c - d;
+}
+
+template <std::size_t N>
+void bench_size(std::size_t elements) {
+  using Fast = numeric::Array<float, N>;
+  using Naive = NaiveArray<float, N>;
+  const std::size_t repeats = std::max<std::size_t>(1, elements / N);
+  const std::size_t ops = repeats * N;
+  Fast fa{}, fb{}, fc{}, fd{}, fr{};
+  Naive na{}, nb{}, nc{}, nd{}, nr{};
+  for (std::size_t i = 0; i < N; ++i) {
+    fa[i] = na.array[i] = static_cast<float>(i % 17);
+    fb[i] = nb.array[i] = 0.5F;
+    fc[i] = nc.array[i] = static_cast<float>(i % 5);
+    fd[i] = nd.array[i] = 1.0F;
+  }
+  std::println("N = {}", N);
+  utils::run_benchmark("  a + b * c - d, temporaries", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      evaluate(nr, na, nb, nc, nd);
+    }
+    utils::do_not_optimize(nr);
+  });
+  utils::run_benchmark("  a + b * c - d, expression template", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      evaluate(fr, fa, fb, fc, fd);
+    }
+    utils::do_not_optimize(fr);
+  });
+  utils::run_benchmark("  sum(a * b), temporaries", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(na);
+      utils::do_not_optimize(naive_sum(na * nb));
+    }
+  });
+  utils::run_benchmark("  dot(a, b), expression template", ops, [&] {
+    for (std::size_t r = 0; r < repeats; ++r) {
+      utils::do_not_optimize(fa);
+      utils::do_not_optimize(numeric::dot(fa, fb));
+    }
+  });
+}
+
+template <std::size_t... N>
+void bench_sizes(std::size_t elements) {
+  (bench_size<N>(elements), ...);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t elements = utils::arg_or(argc, argv, 1, 10'000'000);
+  bench_sizes<4, 16, 64, 256, 1024, 4096>(elements);
+  return 0;
+}
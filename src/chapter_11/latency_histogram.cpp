@@ -0,0 +1,148 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 23:30:26
+# Desc   :
+########################################################################
+*/
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <print>
+#include <thread>
+#include <utility>
+
+namespace latency {
+
+namespace {
+
+double calibrate() {
+#if defined(__x86_64__) || defined(__i386__)
+  const auto start = std::chrono::steady_clock::now();
+  const std::uint64_t start_cycles = cycle_now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  const std::uint64_t cycles = cycle_now() - start_cycles;
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return cycles == 0 ? 1.0 : ns / static_cast<double>(cycles);
+#else
+  return 1.0;  // cycle_now() 直接返回纳秒
+#endif
+}
+
+std::atomic<std::size_t> g_next_site_id{0};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<CallSite*> sites;
+};  // struct Registry
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+}  // namespace
+
+double ns_per_cycle() {
+  static const double value = calibrate();
+  return value;
+}
+
+void Histogram::merge(const Histogram& other) {
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    counts_[i].fetch_add(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+void Histogram::reset() {
+  for (auto& c : counts_) {
+    c.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::uint64_t Histogram::count() const {
+  std::uint64_t total = 0;
+  for (const auto& c : counts_) {
+    total += c.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+std::uint64_t Histogram::percentile(double q) const {
+  const std::uint64_t total = count();
+  if (total == 0) {
+    return 0;
+  }
+  // 第 rank 个(从 1 开始)值所在的桶
+  const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(q * static_cast<double>(total) + 0.5));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += counts_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return upper_bound_of(i);
+    }
+  }
+  return upper_bound_of(kBuckets - 1);
+}
+
+CallSite::CallSite(std::string name) : name_(std::move(name)), id_(g_next_site_id.fetch_add(1)) {
+  auto& r = registry();
+  std::lock_guard lock(r.mutex);
+  r.sites.push_back(this);
+}
+
+CallSite::~CallSite() {
+  auto& r = registry();
+  std::lock_guard lock(r.mutex);
+  std::erase(r.sites, this);
+}
+
+Histogram& CallSite::add_thread() {
+  auto& histograms = detail::t_histograms;
+  if (id_ >= histograms.size()) {
+    histograms.resize(id_ + 1, nullptr);
+  }
+  std::lock_guard lock(mutex_);
+  histograms[id_] = histograms_.emplace_back(std::make_unique<Histogram>()).get();
+  return *histograms[id_];
+}
+
+Histogram CallSite::merge() const {
+  Histogram result;
+  std::lock_guard lock(mutex_);
+  for (const auto& h : histograms_) {
+    result.merge(*h);
+  }
+  return result;
+}
+
+void CallSite::reset() {
+  std::lock_guard lock(mutex_);
+  for (auto& h : histograms_) {
+    h->reset();
+  }
+}
+
+void CallSite::report() const {
+  const Histogram h = merge();
+  const double scale = ns_per_cycle();
+  auto ns = [&](double q) { return static_cast<double>(h.percentile(q)) * scale; };
+  std::println("{}: count = {}, p50 = {:.1f} ns, p99 = {:.1f} ns, p999 = {:.1f} ns", name_, h.count(), ns(0.5),
+      ns(0.99), ns(0.999));
+}
+
+void report_all() {
+  auto& r = registry();
+  std::lock_guard lock(r.mutex);
+  for (const CallSite* site : r.sites) {
+    site->report();
+  }
+}
+
+}  // namespace latency
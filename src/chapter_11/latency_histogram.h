@@ -0,0 +1,171 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 23:12:40
+# Desc   : 按调用点统计延迟的直方图, 用于 11.1.3 的 call / call2
+########################################################################
+*/
+/*
+1. 计时用 rdtsc(非 x86 平台用 steady_clock), 第一次使用时和 steady_clock 对比, 校准出每个 cycle 的纳秒数
+2. Histogram: HDR 风格的对数-线性分桶
+   a. 小于 2 * kSubBuckets 的值每个值一个桶
+   b. 之后每个 2 的幂区间 [2^k, 2^(k+1)) 均分为 kSubBuckets 个桶, 相对误差不超过 1 / kSubBuckets(约 3%)
+   c. 记录只是对一个桶计数, 没有锁; 每个线程只写自己的直方图, 所以只需要 relaxed 的 load + store
+3. CallSite: 一个调用点, 每个线程第一次经过时为它创建一个直方图(此时加锁登记), 之后都是无锁的
+   线程退出后直方图仍然由 CallSite 持有, merge() 随时可以把所有线程的直方图合并后查询 p50 / p99 / p999
+4. LATENCY_SCOPE(name): 在当前作用域结束时记录耗时; LATENCY_FUNCTION_SCOPE() 用函数签名作为名字
+   函数模板的每个实例有自己的 static CallSite, 所以 call<F, Args...> 的每种实例化都是一个独立的调用点
+   report_all() 打印所有调用点
+   只有定义了 LATENCY_HISTOGRAM_ENABLED 才生效, 否则展开为空语句, 被包装的函数和没有插桩时完全相同
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace latency {
+
+inline std::uint64_t cycle_now() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// 每个 cycle 的纳秒数, 第一次调用时校准(约 10 ms)
+double ns_per_cycle();
+
+class Histogram {
+public:
+  static constexpr unsigned kSubBucketBits = 5;
+  static constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBucketBits;
+  static constexpr std::size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  static constexpr std::size_t bucket_of(std::uint64_t value) {
+    if (value < 2 * kSubBuckets) {
+      return static_cast<std::size_t>(value);
+    }
+    const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - (kSubBucketBits + 1);
+    return static_cast<std::size_t>((shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets));
+  }
+  // 桶中的最大值, 查询分位数时返回它(偏大, 不会低估延迟)
+  static constexpr std::uint64_t upper_bound_of(std::size_t bucket) {
+    if (bucket < 2 * kSubBuckets) {
+      return bucket;
+    }
+    const std::size_t shift = bucket / kSubBuckets - 1;
+    const std::uint64_t sub = bucket % kSubBuckets + kSubBuckets;
+    return ((sub + 1) << shift) - 1;
+  }
+
+  Histogram() = default;
+  // 拷贝时逐个桶读取计数, 用于返回合并的结果
+  Histogram(const Histogram& other) { merge(other); }
+  Histogram& operator=(const Histogram&) = delete;
+
+  // 只能由拥有者线程调用
+  void record(std::uint64_t value) {
+    auto& c = counts_[bucket_of(value)];
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  void merge(const Histogram& other);
+  void reset();
+  std::uint64_t count() const;
+  // q in [0, 1], 例如 0.99
+  std::uint64_t percentile(double q) const;
+
+private:
+  std::array<std::atomic<std::uint64_t>, kBuckets> counts_{};
+};  // class Histogram
+
+namespace detail {
+
+// 当前线程在各个 CallSite 的直方图, 下标是 CallSite 的 id
+inline thread_local std::vector<Histogram*> t_histograms;
+
+}  // namespace detail
+
+class CallSite {
+public:
+  explicit CallSite(std::string name);
+  CallSite(const CallSite&) = delete;
+  CallSite& operator=(const CallSite&) = delete;
+  ~CallSite();
+
+  const std::string& name() const { return name_; }
+
+  void record(std::uint64_t cycles) { local().record(cycles); }
+  // 合并所有线程的直方图, 单位是 cycle
+  Histogram merge() const;
+  void reset();
+  // 打印 count 和 p50 / p99 / p999(纳秒)
+  void report() const;
+
+private:
+  Histogram& local() {
+    const auto& histograms = detail::t_histograms;
+    if (id_ < histograms.size() && histograms[id_] != nullptr) [[likely]] {
+      return *histograms[id_];
+    }
+    return add_thread();
+  }
+  // 当前线程第一次经过这个调用点
+  Histogram& add_thread();
+
+  std::string name_;
+  std::size_t id_;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Histogram>> histograms_;
+};  // class CallSite
+
+class ScopedTimer {
+public:
+  explicit ScopedTimer(CallSite& site) : site_(site), start_(cycle_now()) {}
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ~ScopedTimer() { site_.record(cycle_now() - start_); }
+
+private:
+  CallSite& site_;
+  std::uint64_t start_;
+};  // class ScopedTimer
+
+// 打印所有调用点的统计结果
+void report_all();
+
+}  // namespace latency
+
+#define LATENCY_CONCAT_IMPL(a, b) a##b
+#define LATENCY_CONCAT(a, b) LATENCY_CONCAT_IMPL(a, b)
+
+#ifdef LATENCY_HISTOGRAM_ENABLED
+#define LATENCY_SCOPE(name)                                                                   \
+  static ::latency::CallSite LATENCY_CONCAT(latency_site_, __LINE__){name};                  \
+  const ::latency::ScopedTimer LATENCY_CONCAT(latency_timer_, __LINE__) {                     \
+    LATENCY_CONCAT(latency_site_, __LINE__)                                                   \
+  }
+#else
+#define LATENCY_SCOPE(name) static_cast<void>(0)
+#endif
+#define LATENCY_FUNCTION_SCOPE() LATENCY_SCOPE(std::source_location::current().function_name())
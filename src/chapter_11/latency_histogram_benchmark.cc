@@ -0,0 +1,102 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 23:52:08
+# Desc   : LATENCY_SCOPE 插桩的开销: 每次调用增加的纳秒数
+########################################################################
+*/
+/*
+用法: chapter_11_latency_histogram_benchmark [calls] [threads]
+这个文件总是定义 LATENCY_HISTOGRAM_ENABLED(见 CMakeLists.txt), 未插桩的版本是同样的函数去掉 LATENCY_SCOPE
+1. cycle_now(): 一次 rdtsc
+2. Histogram::record(): 计算桶的下标并计数
+3. 被包装的函数是一个很小的 noinline 函数, 对比插桩前后 call 的耗时, 差值就是每次调用的开销
+4. 多个线程同时经过同一个调用点, 各自写自己的直方图, 开销不应该随线程数增加
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <print>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "latency_histogram.h"
+
+UTILS_NOINLINE int work(int x) {
+  return x * 3 + 1;
+}
+
+template <typename Callable, typename... Args>
+decltype(auto) call_plain(Callable&& op, Args&&... args) {
+  return std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
+}
+
+template <typename Callable, typename... Args>
+decltype(auto) call_timed(Callable&& op, Args&&... args) {
+  LATENCY_SCOPE("call_timed(work)");
+  return std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t calls = utils::arg_or(argc, argv, 1, 10'000'000);
+  const std::size_t threads = std::max<std::size_t>(1, utils::arg_or(argc, argv, 2, 4));
+  std::println("ns per cycle: {:.4f}", latency::ns_per_cycle());
+
+  utils::run_benchmark("cycle_now()", calls, [&] {
+    for (std::size_t i = 0; i < calls; ++i) {
+      utils::do_not_optimize(latency::cycle_now());
+    }
+  });
+  latency::Histogram h;
+  utils::run_benchmark("Histogram::record()", calls, [&] {
+    for (std::size_t i = 0; i < calls; ++i) {
+      h.record(i & 0xFFFF);
+    }
+    utils::do_not_optimize(h);
+  });
+
+  int x = 0;
+  const auto plain = utils::run_benchmark("call(work), plain", calls, [&] {
+    for (std::size_t i = 0; i < calls; ++i) {
+      x = call_plain(work, x);
+    }
+    utils::do_not_optimize(x);
+  });
+  const auto timed = utils::run_benchmark("call(work), LATENCY_SCOPE", calls, [&] {
+    for (std::size_t i = 0; i < calls; ++i) {
+      x = call_timed(work, x);
+    }
+    utils::do_not_optimize(x);
+  });
+  std::println("overhead: {:.2f} ns per call", timed.ns_per_op() - plain.ns_per_op());
+
+  // 多个线程同时经过同一个调用点
+  const std::size_t per_thread = calls / threads;
+  utils::run_benchmark("call(work), LATENCY_SCOPE, threads", per_thread * threads, [&] {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([per_thread] {
+        int y = 0;
+        for (std::size_t i = 0; i < per_thread; ++i) {
+          y = call_timed(work, y);
+        }
+        utils::do_not_optimize(y);
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+  });
+  latency::report_all();
+  return 0;
+}
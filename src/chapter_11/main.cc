@@ -11,13 +11,29 @@
 ########################################################################
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <numeric>
 #include <print>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "cpp_utils/util.h"
 
+#include "latency_histogram.h"
+#include "memoize.h"
+#include "node_pool.h"
+#include "parallel_foreach.h"
+#include "soa.h"
+
 // 11.1 可调用对象
 /* callable
 1. function pointer
@@ -84,10 +100,57 @@ void run_foreach_for_member_function() {
   std::println();
 }
 
+// 带执行策略的 foreach, 见 parallel_foreach.h
+class Counter {
+public:
+  void add(int i) const {
+    sum.fetch_add(i, std::memory_order_relaxed);
+  }
+  mutable std::atomic<int64_t> sum{0};
+};  // class Counter
+
+void run_parallel_foreach() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::vector<int> v(100'000);
+  std::iota(v.begin(), v.end(), 0);
+  const int64_t expected = int64_t{99'999} * 100'000 / 2;
+  auto check = [&](const auto& policy) {
+    std::vector<int> visited(v.size(), 0);
+    // 第一个参数在 namespace parallel 中, 通过 ADL 找到带执行策略的 foreach
+    foreach(policy, v.begin(), v.end(), [&](int i) { ++visited[i]; });
+    assert(std::ranges::all_of(visited, [](int n) { return n == 1; }));
+    Counter counter;
+    foreach(policy, v.begin(), v.end(), &Counter::add, counter);
+    assert(counter.sum == expected);
+  };
+  check(parallel::seq);
+  check(parallel::unseq);
+  check(parallel::par);
+  check(parallel::par_unseq);
+  check(parallel::par.with_grain(1));
+
+  // 异常在调用线程中重新抛出
+  bool caught = false;
+  try {
+    foreach(parallel::par.with_grain(16), v.begin(), v.end(), [](int i) {
+      if (i == 77'777) {
+        throw std::runtime_error("bad element");
+      }
+    });
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+  assert(caught);
+  std::println("ok, thread pool workers: {}", parallel::ThreadPool::instance().size());
+  std::println();
+}
+
 // 11.1.3 封装函数调用
 // 1. 使用 decltype(auto) 来支持返回引用类型
+// 定义了 LATENCY_HISTOGRAM_ENABLED 时统计每种实例化的调用延迟, 否则 LATENCY_FUNCTION_SCOPE() 为空, 见 latency_histogram.h
 template <typename Callable, typename... Args>
 decltype(auto) call(Callable&& op, Args&&... args) {
+  LATENCY_FUNCTION_SCOPE();
   // decltype(auto) ret = std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
   // ...
   // return ret;
@@ -97,6 +160,7 @@ decltype(auto) call(Callable&& op, Args&&... args) {
 // 2. 需要处理 decltype(auto) 为 void 的情况, 因为不能 return void
 template <typename Callable, typename... Args>
 decltype(auto) call2(Callable&& op, Args&&... args) {
+  LATENCY_FUNCTION_SCOPE();
   if constexpr (std::is_same_v<std::invoke_result_t<Callable, Args...>, void>) {
     std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
     return ;
@@ -105,6 +169,73 @@ decltype(auto) call2(Callable&& op, Args&&... args) {
   }
 }
 
+void run_call() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::vector<int> v{1, 2, 3};
+  auto at = [](std::vector<int>& c, std::size_t i) -> int& { return c[i]; };
+  call(at, v, 1) = 20;  // 返回 int&
+  call2([](std::vector<int>& c) { c.push_back(4); }, v);  // 返回 void
+  assert(v[1] == 20 && v.size() == 4);
+
+  // 直方图的分桶: 小于 64 的值精确, 之后相对误差不超过 1/32
+  using latency::Histogram;
+  static_assert(Histogram::bucket_of(63) == 63 && Histogram::upper_bound_of(63) == 63);
+  static_assert(Histogram::bucket_of(64) == 64 && Histogram::upper_bound_of(64) == 65);
+  static_assert(Histogram::bucket_of(UINT64_MAX) == Histogram::kBuckets - 1);
+  Histogram h;
+  for (std::uint64_t i = 1; i <= 1000; ++i) {
+    h.record(i);
+  }
+  assert(h.count() == 1000);
+  assert(h.percentile(0.5) >= 500 && h.percentile(0.5) <= 500 + 500 / 32);
+  assert(h.percentile(0.999) >= 999 && h.percentile(0.999) <= 999 + 999 / 32);
+  std::println("p50 = {}, p99 = {}, p999 = {}", h.percentile(0.5), h.percentile(0.99), h.percentile(0.999));
+#ifdef LATENCY_HISTOGRAM_ENABLED
+  latency::report_all();
+#endif
+  std::println();
+}
+
+// 参数重复的纯函数可以先用 memoize 包装, 见 memoize.h
+std::atomic<int> g_slow_calls{0};
+std::string slow_repeat(const std::string& s, int n) {
+  ++g_slow_calls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  std::string r;
+  for (int i = 0; i < n; ++i) {
+    r += s;
+  }
+  return r;
+}
+
+void run_memoize() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  auto fast = memo::memoize(slow_repeat, {.byte_budget = 1 << 16, .shards = 4});
+  assert(call(fast, "ab", 3) == "ababab");
+  assert(call(fast, std::string("ab"), 3) == "ababab");  // 命中
+  assert(g_slow_calls == 1);
+
+  // single-flight: 同时请求同一个 key, 只计算一次
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&fast] { assert(fast("xy", 2) == "xyxy"); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  assert(g_slow_calls == 2);
+
+  // 超过预算时淘汰最久没有使用的条目
+  auto tiny = memo::memoize([](int x) { return std::vector<int>(256, x); }, {.byte_budget = 4096, .shards = 1});
+  for (int i = 0; i < 10; ++i) {
+    tiny(i);
+  }
+  const auto stats = tiny.stats();
+  assert(stats.entries == 3 && stats.evictions == 7 && stats.bytes <= 4096);
+  std::println("entries = {}, evictions = {}, bytes = {}", stats.entries, stats.evictions, stats.bytes);
+  std::println();
+}
+
 // 11.2 实现泛型库的其他工具
 // 11.2.1 类型特征
 template <typename T>
@@ -298,6 +429,48 @@ void run_arr2() {
   // Arr2<int&> a2;
 }
 
+// 多个数组共享同一个长度的正确做法: 长度由容器自己维护, 见 soa.h
+void run_soa() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  columns::soa<float, float, std::string> s;
+  s.push_back(1.0F, 10.0F, "a");
+  s.push_back(2.0F, 20.0F, "b");
+  s.emplace_back(3.0F, 30.0F, "c");
+  assert(s.size() == 3 && s.column<0>().size() == 3 && s.column<2>().size() == 3);
+
+  // 按行迭代, 结构化绑定得到的是引用
+  for (auto [x, y, name] : s) {
+    x += y;
+    name += "!";
+  }
+  // 按列访问, 每一列都是连续且按 cache line 对齐的数组
+  float sum = 0;
+  for (float x : s.column<0>()) {
+    sum += x;
+  }
+  assert(sum == 66.0F);
+  assert(reinterpret_cast<std::uintptr_t>(s.data<1>()) % 64 == 0);
+
+  s[1] = std::tuple{0.0F, 0.0F, std::string("z")};
+  auto copy = s;
+  s.resize(1);
+  assert(s.size() == 1 && copy.size() == 3 && std::get<2>(copy[1]) == "z" && std::get<2>(copy[2]) == "c!");
+  for (const auto& [x, y, name] : copy) {
+    std::print("({}, {}, {}) ", x, y, name);
+  }
+  std::println();
+
+  // 插入已有元素的引用, 跨过扩容的边界: 先构造新的一行, 再搬运旧的元素
+  columns::soa<std::string, int> t;
+  t.push_back(std::string(32, 'x'), 0);
+  while (t.size() < t.capacity()) {
+    t.push_back(std::get<0>(t[0]), static_cast<int>(t.size()));
+  }
+  auto [str, n] = t[0];
+  t.push_back(str, n);
+  assert(t.size() == 17 && t.capacity() == 32 && std::get<0>(t[16]) == std::string(32, 'x') && std::get<1>(t[16]) == 0);
+}
+
 // 11.5 推迟估算
 template <typename T>
 class Cont {
@@ -341,15 +514,33 @@ void run_node() {
   // Cont3 中将 foo 从普通函数换成了模板函数，这样 std::is_move_constructible 就会推迟到 foo 函数实例化时
   // 当 foo 实例化的时候, Node 已经被编译器完整可见了
   Node<Cont3> n3;
+
+  // PoolPtr 也只是声明了 Node 类型的下标, 节点在 Pool 中按块分配, 用 32 位下标链接, 见 node_pool.h
+  static_assert(sizeof(pooled::PoolPtr<Node<pooled::PoolPtr>>) == 4);
+  pooled::Pool<Node<pooled::PoolPtr>> pool;
+  pooled::PoolPtr<Node<pooled::PoolPtr>> head;
+  for (const char* value : {"c", "b", "a"}) {
+    head = pool.create(value, head);
+  }
+  for (auto p = head; p; p = pool[p].next) {
+    std::print("{} ", pool[p].value);
+  }
+  std::println();
+  pool.release();  // 一次释放整个链表
+  assert(pool.size() == 0);
 }
 
 int main() {
   run_foreach();
   run_foreach_for_member_function();
+  run_parallel_foreach();
+  run_call();
+  run_memoize();
   run_param_reference();
   run_ref_mem();
   run_arr();
   run_arr2();
+  run_soa();
   run_node();
   return 0;
 }
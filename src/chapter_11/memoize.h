@@ -0,0 +1,254 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 00:15:37
+# Desc   : memoize: 为纯函数缓存结果, 分片 LRU + 字节预算 + single-flight
+########################################################################
+*/
+/*
+11.1.3 的 call 每次都重新调用 op, 对于参数经常重复、耗时的纯函数, 可以先用 memoize 包装一下
+  auto fast = memo::memoize(slow, {.byte_budget = 1 << 20});
+  call(fast, 42);  // Memoized 本身也是一个可调用对象
+1. 参数和返回值的类型从 op 的签名推导(函数指针, 或者 operator() 不是模板的函数对象), 参数按 decay 后的类型保存为 key
+   op 必须可以通过 const 引用调用(不能是 mutable lambda), 不同的 key 会在多个线程中同时调用它
+   每个参数类型都需要 std::hash 和 ==
+2. 缓存分为 shards 个分片, 按 key 的哈希选择分片, 每个分片有自己的锁、哈希表和 LRU 链表, 减少线程之间的竞争
+3. byte_budget 是所有分片的总预算, 每个分片分到 byte_budget / shards
+   一个条目的大小由 bytes_of 估算: sizeof 加上 string / vector 等容器的 capacity, 再加上链表和哈希表节点的开销
+   超出预算时淘汰最久没有使用的条目, 比单个分片预算还大的结果不缓存
+4. single-flight: 多个线程同时请求同一个不在缓存中的 key 时, 只有第一个线程调用 op, 其他线程等待它的结果
+   op 抛出的异常会传给所有等待的线程, 并且不缓存
+5. 结果按值返回(拷贝一份), 所以返回值类型需要可以拷贝
+*/
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace memo {
+
+struct MemoizeOptions {
+  std::size_t byte_budget{64 << 20};
+  std::size_t shards{16};
+};  // struct MemoizeOptions
+
+struct MemoizeStats {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};     // 调用 op 的次数
+  std::uint64_t collapsed{0};  // 等待其他线程计算结果的次数
+  std::uint64_t evictions{0};
+  std::size_t entries{0};
+  std::size_t bytes{0};
+
+  double hit_rate() const {
+    const auto total = hits + misses + collapsed;
+    return total == 0 ? 0.0 : static_cast<double>(hits + collapsed) / static_cast<double>(total);
+  }
+};  // struct MemoizeStats
+
+namespace detail {
+
+// 从可调用对象的签名推导参数和返回值
+template <typename F>
+struct CallableTraits : CallableTraits<decltype(&F::operator())> {};
+template <typename R, typename... A>
+struct CallableTraits<R (*)(A...)> {
+  using key_type = std::tuple<std::decay_t<A>...>;
+  using result_type = std::decay_t<R>;
+};  // struct CallableTraits<R (*)(A...)>
+template <typename R, typename... A>
+struct CallableTraits<R(A...)> : CallableTraits<R (*)(A...)> {};
+// operator() 不是 const 的函数对象(例如 mutable lambda)不支持: Memoized::operator() 是 const 的, 并且会被多个线程同时调用
+template <typename R, typename C, typename... A>
+struct CallableTraits<R (C::*)(A...)> {
+  static_assert(sizeof(C) == 0, "memo::memoize: op must be const-callable (mutable lambdas are not supported)");
+};  // struct CallableTraits<R (C::*)(A...)>
+template <typename R, typename C, typename... A>
+struct CallableTraits<R (C::*)(A...) const> : CallableTraits<R (*)(A...)> {};
+
+template <typename T>
+std::size_t bytes_of(const T& value) {
+  if constexpr (requires { value.capacity(); typename T::value_type; }) {
+    return sizeof(T) + value.capacity() * sizeof(typename T::value_type);
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    return std::apply([](const auto&... e) { return (std::size_t{0} + ... + bytes_of(e)); }, value);
+  } else {
+    return sizeof(T);
+  }
+}
+
+inline std::size_t hash_combine(std::size_t seed, std::size_t h) {
+  return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+// std::hash<int> 通常就是值本身, 再混合一次让高位也均匀, 分片使用高位
+inline std::size_t mix(std::size_t h) {
+  std::uint64_t x = h;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  return static_cast<std::size_t>(x);
+}
+
+template <typename Key>
+struct TupleHash {
+  std::size_t operator()(const Key& key) const {
+    return std::apply([](const auto&... e) {
+      std::size_t seed = 0;
+      ((seed = hash_combine(seed, std::hash<std::decay_t<decltype(e)>>{}(e))), ...);
+      return mix(seed);
+    }, key);
+  }
+};  // struct TupleHash
+
+// 链表节点(两个指针) + 哈希表节点(next 指针、缓存的哈希值、链表迭代器) 的近似开销
+inline constexpr std::size_t kEntryOverhead = 6 * sizeof(void*);
+
+}  // namespace detail
+
+template <typename Callable>
+class Memoized {
+  using Traits = detail::CallableTraits<std::remove_cvref_t<Callable>>;
+
+public:
+  using key_type = typename Traits::key_type;
+  using result_type = typename Traits::result_type;
+
+  explicit Memoized(Callable op, MemoizeOptions options = {})
+      : op_(std::move(op)),
+        shard_budget_(options.byte_budget / std::bit_ceil(std::max<std::size_t>(options.shards, 1))),
+        shards_(std::bit_ceil(std::max<std::size_t>(options.shards, 1))) {}
+
+  template <typename... Args>
+  result_type operator()(Args&&... args) const {
+    key_type key(std::forward<Args>(args)...);
+    const std::size_t hash = detail::TupleHash<key_type>{}(key);
+    // 低位给分片内部的哈希表使用, 分片用高位选择
+    Shard& shard = shards_[(hash >> (sizeof(std::size_t) * 4)) & (shards_.size() - 1)];
+
+    std::unique_lock lock(shard.mutex);
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      ++shard.hits;
+      return it->second->value;
+    }
+    if (auto it = shard.in_flight.find(key); it != shard.in_flight.end()) {
+      auto future = it->second;
+      ++shard.collapsed;
+      lock.unlock();
+      return future.get();
+    }
+    std::promise<result_type> promise;
+    shard.in_flight.emplace(key, promise.get_future().share());
+    ++shard.misses;
+    lock.unlock();
+
+    result_type value = [&]() -> result_type {
+      try {
+        return std::apply(op_, key);
+      } catch (...) {
+        lock.lock();
+        shard.in_flight.erase(key);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+      }
+    }();
+    lock.lock();
+    shard.in_flight.erase(key);
+    insert(shard, std::move(key), value);
+    lock.unlock();
+    promise.set_value(value);
+    return value;
+  }
+
+  MemoizeStats stats() const {
+    MemoizeStats s;
+    for (auto& shard : shards_) {
+      std::lock_guard lock(shard.mutex);
+      s.hits += shard.hits;
+      s.misses += shard.misses;
+      s.collapsed += shard.collapsed;
+      s.evictions += shard.evictions;
+      s.entries += shard.lru.size();
+      s.bytes += shard.bytes;
+    }
+    return s;
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard lock(shard.mutex);
+      shard.index.clear();
+      shard.lru.clear();
+      shard.bytes = 0;
+    }
+  }
+
+private:
+  struct Entry {
+    key_type key;
+    result_type value;
+    std::size_t bytes;
+  };  // struct Entry
+  using LruList = std::list<Entry>;
+
+  struct Shard {
+    std::mutex mutex;
+    LruList lru;  // 头部是最近使用的
+    std::unordered_map<key_type, typename LruList::iterator, detail::TupleHash<key_type>> index;
+    std::unordered_map<key_type, std::shared_future<result_type>, detail::TupleHash<key_type>> in_flight;
+    std::size_t bytes{0};
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t collapsed{0};
+    std::uint64_t evictions{0};
+  };  // struct Shard
+
+  // 调用者持有 shard.mutex
+  void insert(Shard& shard, key_type key, const result_type& value) const {
+    // key 在链表和哈希表中各保存一份
+    const std::size_t bytes = 2 * detail::bytes_of(key) + detail::bytes_of(value) + detail::kEntryOverhead;
+    if (bytes > shard_budget_) {
+      return;
+    }
+    while (shard.bytes + bytes > shard_budget_ && !shard.lru.empty()) {
+      const Entry& victim = shard.lru.back();
+      shard.bytes -= victim.bytes;
+      shard.index.erase(victim.key);
+      shard.lru.pop_back();
+      ++shard.evictions;
+    }
+    shard.lru.push_front(Entry{key, value, bytes});
+    shard.index.emplace(std::move(key), shard.lru.begin());
+    shard.bytes += bytes;
+  }
+
+  Callable op_;
+  std::size_t shard_budget_;
+  mutable std::vector<Shard> shards_;
+};  // class Memoized
+
+template <typename Callable>
+Memoized<std::decay_t<Callable>> memoize(Callable&& op, MemoizeOptions options = {}) {
+  return Memoized<std::decay_t<Callable>>(std::forward<Callable>(op), options);
+}
+
+}  // namespace memo
@@ -0,0 +1,107 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 00:48:21
+# Desc   : memo::memoize 在 Zipf 分布的参数下的命中率和吞吐
+########################################################################
+*/
+/*
+用法: chapter_11_memoize_benchmark [calls] [keys] [threads]
+1. 参数从 [0, keys) 中按 Zipf 分布(s = 0.99)抽取, 少数热点参数占了大部分调用, 抽样在计时之前完成
+2. 被缓存的函数做约 1 µs 的整数运算, 返回一个 uint64_t
+3. 字节预算分别能容纳全部 / 10% / 1% 的 key, 打印命中率和每次调用的耗时
+4. 多线程时所有线程共享一个 Memoized 对象, 对比 1 个分片和 16 个分片(锁竞争)
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <print>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "memoize.h"
+
+std::uint64_t expensive(std::uint64_t x) {
+  std::uint64_t h = x;
+  for (int r = 0; r < 400; ++r) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+  }
+  return h;
+}
+
+std::vector<std::uint64_t> zipf_samples(std::size_t n, std::size_t keys, double s) {
+  std::vector<double> cdf(keys);
+  double sum = 0.0;
+  for (std::size_t k = 0; k < keys; ++k) {
+    sum += 1.0 / std::pow(static_cast<double>(k + 1), s);
+    cdf[k] = sum;
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> uniform(0.0, sum);
+  std::vector<std::uint64_t> samples(n);
+  for (auto& x : samples) {
+    x = static_cast<std::uint64_t>(std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+  }
+  return samples;
+}
+
+// 每个线程处理 samples 中交错的一部分
+template <typename F>
+void run_threads(std::size_t threads, const std::vector<std::uint64_t>& samples, F& f) {
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::uint64_t acc = 0;
+      for (std::size_t i = t; i < samples.size(); i += threads) {
+        acc += f(samples[i]);
+      }
+      utils::do_not_optimize(acc);
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::size_t calls = utils::arg_or(argc, argv, 1, 1'000'000);
+  const std::size_t keys = utils::arg_or(argc, argv, 2, 100'000);
+  const std::size_t threads = utils::arg_or(argc, argv, 3, 4);
+  const auto samples = zipf_samples(calls, keys, 0.99);
+  // 一个 uint64_t -> uint64_t 条目的估算大小, 见 Memoized::insert
+  const std::size_t entry_bytes = 3 * sizeof(std::uint64_t) + memo::detail::kEntryOverhead;
+
+  auto plain = [](std::uint64_t x) { return expensive(x); };
+  utils::run_benchmark("no cache", calls, [&] { run_threads(1, samples, plain); }, 1);
+
+  for (std::size_t percent : {100, 10, 1}) {
+    const std::size_t budget = keys * percent / 100 * entry_bytes;
+    auto cached = memo::memoize(expensive, {.byte_budget = budget});
+    // 第一次运行预热缓存, 之后的运行是稳定状态
+    utils::run_benchmark(std::format("memoize, budget {}% of keys", percent), calls,
+        [&] { run_threads(1, samples, cached); });
+    const auto stats = cached.stats();
+    std::println("  hit rate {:.2f}%, entries {}, evictions {}", stats.hit_rate() * 100, stats.entries,
+        stats.evictions);
+  }
+
+  for (std::size_t shards : {1, 16}) {
+    auto cached = memo::memoize(expensive, {.byte_budget = keys / 10 * entry_bytes, .shards = shards});
+    utils::run_benchmark(std::format("memoize, {} threads, {} shard(s)", threads, shards), calls,
+        [&] { run_threads(threads, samples, cached); });
+    std::println("  hit rate {:.2f}%", cached.stats().hit_rate() * 100);
+  }
+  return 0;
+}
@@ -0,0 +1,132 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 01:58:40
+# Desc   : pooled::PoolPtr<T>: 作为 Node<template C> 的 C, 用 32 位下标链接池中的节点
+########################################################################
+*/
+/*
+11.5 的 Node<Cont> 中 Cont<Node> 保存一个 T* elem, 每个节点单独在堆上分配, 用 8 字节的指针链接
+1. PoolPtr<T> 只保存一个 uint32_t 下标, 和 Cont 一样不需要 T 是完整类型, 所以也可以用在 Node 的定义中
+   Node<pooled::PoolPtr> 的 next 只有 4 字节
+2. Pool<T> 按块(每块 kChunkSize 个 T)分配节点, 块的地址不变, 所以节点的地址也不会变
+   下标的高位是块号, 低位是块内的偏移
+3. 下标必须通过创建它的 Pool 访问: pool[node.next]
+4. 不支持单独释放一个节点, 整个结构一起释放:
+   clear() 析构所有节点但保留内存, release() 析构所有节点并归还内存, 析构 Pool 时自动 release()
+   T 是 trivially destructible 时 clear() 不需要逐个访问节点
+*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pooled {
+
+template <typename T>
+class Pool;
+
+template <typename T>
+class PoolPtr {
+public:
+  static constexpr std::uint32_t kNull = std::numeric_limits<std::uint32_t>::max();
+
+  constexpr PoolPtr() = default;
+  constexpr PoolPtr(std::nullptr_t) {}
+
+  constexpr std::uint32_t index() const { return index_; }
+  constexpr explicit operator bool() const { return index_ != kNull; }
+  friend constexpr bool operator==(PoolPtr, PoolPtr) = default;
+
+private:
+  friend class Pool<T>;
+  constexpr explicit PoolPtr(std::uint32_t index) : index_(index) {}
+
+  std::uint32_t index_{kNull};
+};  // class PoolPtr
+
+template <typename T>
+class Pool {
+public:
+  static constexpr unsigned kChunkBits = 16;
+  static constexpr std::size_t kChunkSize = std::size_t{1} << kChunkBits;
+  static constexpr std::size_t kMaxSize = PoolPtr<T>::kNull;
+
+  Pool() = default;
+  Pool(const Pool&) = delete;
+  Pool& operator=(const Pool&) = delete;
+  Pool(Pool&& other) noexcept : chunks_(std::move(other.chunks_)), size_(std::exchange(other.size_, 0)) {}
+  Pool& operator=(Pool&& other) noexcept {
+    if (this != &other) {
+      release();
+      chunks_ = std::move(other.chunks_);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+  ~Pool() { release(); }
+
+  template <typename... Args>
+  PoolPtr<T> create(Args&&... args) {
+    assert(size_ < kMaxSize);
+    const std::size_t chunk = size_ >> kChunkBits;
+    if (chunk == chunks_.size()) {
+      chunks_.push_back(std::make_unique_for_overwrite<Slot[]>(kChunkSize));
+    }
+    std::construct_at(address(size_), std::forward<Args>(args)...);
+    return PoolPtr<T>(static_cast<std::uint32_t>(size_++));
+  }
+
+  T& operator[](PoolPtr<T> p) {
+    assert(p && p.index() < size_);
+    return *address(p.index());
+  }
+  const T& operator[](PoolPtr<T> p) const {
+    assert(p && p.index() < size_);
+    return *address(p.index());
+  }
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return chunks_.size() * kChunkSize; }
+
+  // 析构所有节点, 保留已经分配的块
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (std::size_t i = 0; i < size_; ++i) {
+        std::destroy_at(address(i));
+      }
+    }
+    size_ = 0;
+  }
+  // 析构所有节点, 归还所有的块
+  void release() {
+    clear();
+    chunks_.clear();
+  }
+
+private:
+  struct Slot {
+    alignas(T) std::byte bytes[sizeof(T)];
+  };  // struct Slot
+
+  T* address(std::size_t index) const {
+    return std::launder(reinterpret_cast<T*>(chunks_[index >> kChunkBits][index & (kChunkSize - 1)].bytes));
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> chunks_;
+  std::size_t size_{0};
+};  // class Pool
+
+}  // namespace pooled
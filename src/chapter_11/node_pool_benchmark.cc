@@ -0,0 +1,121 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 02:21:05
+# Desc   : Node<pooled::PoolPtr> 与 Node<Cont>(裸指针, 每个节点单独 new) 的对比
+########################################################################
+*/
+/*
+用法: chapter_11_node_pool_benchmark [nodes]
+默认 1M 个节点, 需要 10M 个节点时传入 10000000
+和 11.5 一样的 Node<template C>, 只是 value 换成 uint32_t, 节点大小:
+  Node<RawCont>: 4 字节 value + 8 字节指针 = 16 字节(对齐后), 另外每次 new 还有 malloc 的头部
+  Node<PoolPtr>: 4 字节 value + 4 字节下标 = 8 字节
+1. build: 创建 nodes 个节点并链接成链表
+2. traverse: 沿 next 遍历整个链表
+   sequential: 按创建顺序链接; shuffled: 按随机顺序链接, 每一步都跳到内存中的随机位置
+3. teardown: 裸指针需要逐个 delete, Pool 一次 release()
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <print>
+#include <random>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "node_pool.h"
+
+template <template <typename T> class C>
+struct Node {
+  std::uint32_t value;
+  C<Node> next;
+};  // struct Node
+
+// 11.5 的 Cont, 把指针改为 public 以便链接
+template <typename T>
+struct RawCont {
+  T* elem{nullptr};
+};  // struct RawCont
+
+using RawNode = Node<RawCont>;
+using PoolNode = Node<pooled::PoolPtr>;
+
+// order[i] 是第 i 个创建的节点在链表中的位置
+void bench_raw(const std::vector<std::uint32_t>& order) {
+  const std::size_t n = order.size();
+  std::vector<RawNode*> nodes(n);
+  RawNode* head = nullptr;
+  utils::run_benchmark("  build, Node<RawCont>", n, [&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      nodes[i] = new RawNode{static_cast<std::uint32_t>(i), {}};
+    }
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+      nodes[order[i]]->next.elem = nodes[order[i + 1]];
+    }
+    head = nodes[order[0]];
+  }, 1);
+  utils::run_benchmark("  traverse, Node<RawCont>", n, [&] {
+    std::uint64_t sum = 0;
+    for (const RawNode* p = head; p != nullptr; p = p->next.elem) {
+      sum += p->value;
+    }
+    utils::do_not_optimize(sum);
+  });
+  utils::run_benchmark("  teardown, Node<RawCont>", n, [&] {
+    for (RawNode* p = head; p != nullptr;) {
+      RawNode* next = p->next.elem;
+      delete p;
+      p = next;
+    }
+  }, 1);
+}
+
+void bench_pool(const std::vector<std::uint32_t>& order) {
+  const std::size_t n = order.size();
+  std::vector<pooled::PoolPtr<PoolNode>> nodes(n);
+  pooled::Pool<PoolNode> pool;
+  pooled::PoolPtr<PoolNode> head;
+  utils::run_benchmark("  build, Node<PoolPtr>", n, [&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      nodes[i] = pool.create(static_cast<std::uint32_t>(i), nullptr);
+    }
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+      pool[nodes[order[i]]].next = nodes[order[i + 1]];
+    }
+    head = nodes[order[0]];
+  }, 1);
+  utils::run_benchmark("  traverse, Node<PoolPtr>", n, [&] {
+    std::uint64_t sum = 0;
+    for (auto p = head; p; p = pool[p].next) {
+      sum += pool[p].value;
+    }
+    utils::do_not_optimize(sum);
+  });
+  utils::run_benchmark("  teardown, Node<PoolPtr>", n, [&] { pool.release(); }, 1);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t n = std::max<std::size_t>(1, utils::arg_or(argc, argv, 1, 1'000'000));
+  std::println("nodes: {}, sizeof(Node<RawCont>) = {}, sizeof(Node<PoolPtr>) = {}", n, sizeof(RawNode),
+      sizeof(PoolNode));
+  std::vector<std::uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::println("sequential");
+  bench_raw(order);
+  bench_pool(order);
+
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  std::println("shuffled");
+  bench_raw(order);
+  bench_pool(order);
+  return 0;
+}
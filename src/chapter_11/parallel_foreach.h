@@ -0,0 +1,204 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 22:32:47
+# Desc   : 带执行策略的 foreach: parallel::seq / unseq / par / par_unseq
+########################################################################
+*/
+/*
+11.1 的两个 foreach 都是串行的循环, 这里增加以执行策略作为第一个参数的重载(和 std::for_each 一样)
+  foreach(parallel::par, v.begin(), v.end(), op);
+  foreach(parallel::par_unseq, v.begin(), v.end(), &MyClass::memfunc, obj);
+第一个实参在 namespace parallel 中, 通过 ADL 就可以找到, 不需要写 parallel::foreach
+1. seq: 和 11.1 相同的串行循环
+2. unseq: 连续存储的区间(std::contiguous_iterator)转成指针 + 下标的循环, 并提示编译器循环之间没有依赖, 便于向量化
+   op 不能加锁或者依赖元素的处理顺序
+3. par: 随机访问迭代器分块后交给 ThreadPool::instance() 执行, 调用者也参与计算; 其他迭代器退化为 seq
+   op 会在多个线程中同时被调用(同一个 op 对象), 需要是线程安全的
+4. par_unseq: par + unseq, 每一块内部使用可以向量化的循环
+5. 分块的大小是自适应的:
+   a. 先串行执行一小段(kProbe 个元素)测出每个元素的耗时, 使每块至少需要 kTargetChunkNs 纳秒, 总耗时太短时直接串行执行
+   b. 之后按 guided 的方式领取: 每次领取剩余元素的 1 / (2 * 线程数), 但不少于上面的最小块, 前面的块大、后面的块小, 负载均衡
+   也可以用 par.with_grain(n) 指定最小块的大小
+6. 异常: op 抛出的第一个异常在所有线程结束后在调用线程中重新抛出, 其他线程不再领取新的块
+   (std::for_each 带执行策略时遇到异常会调用 std::terminate)
+7. 在线程池的工作线程中嵌套调用 par 时串行执行, 避免工作线程互相等待而死锁
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "thread_pool.h"
+
+#if defined(__clang__)
+#define PARALLEL_FOREACH_VECTORIZE _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define PARALLEL_FOREACH_VECTORIZE _Pragma("GCC ivdep")
+#else
+#define PARALLEL_FOREACH_VECTORIZE
+#endif
+
+namespace parallel {
+
+struct SequencedPolicy {};
+struct UnsequencedPolicy {};
+struct ParallelPolicy {
+  std::size_t grain{0};  // 最小块的大小, 0 表示自适应
+  constexpr ParallelPolicy with_grain(std::size_t g) const { return {g}; }
+};  // struct ParallelPolicy
+struct ParallelUnsequencedPolicy {
+  std::size_t grain{0};
+  constexpr ParallelUnsequencedPolicy with_grain(std::size_t g) const { return {g}; }
+};  // struct ParallelUnsequencedPolicy
+
+inline constexpr SequencedPolicy seq{};
+inline constexpr UnsequencedPolicy unseq{};
+inline constexpr ParallelPolicy par{};
+inline constexpr ParallelUnsequencedPolicy par_unseq{};
+
+template <typename P>
+concept ExecutionPolicy = std::is_same_v<P, SequencedPolicy> || std::is_same_v<P, UnsequencedPolicy> ||
+    std::is_same_v<P, ParallelPolicy> || std::is_same_v<P, ParallelUnsequencedPolicy>;
+
+namespace detail {
+
+inline constexpr std::size_t kProbe = 64;
+inline constexpr std::int64_t kTargetChunkNs = 50'000;
+
+template <typename P>
+inline constexpr bool is_parallel_v = std::is_same_v<P, ParallelPolicy> || std::is_same_v<P, ParallelUnsequencedPolicy>;
+template <typename P>
+inline constexpr bool is_unsequenced_v =
+    std::is_same_v<P, UnsequencedPolicy> || std::is_same_v<P, ParallelUnsequencedPolicy>;
+
+// 处理 [first + begin, first + end)
+template <bool kUnsequenced, typename Iter, typename Callable>
+void run_range(Iter first, std::size_t begin, std::size_t end, Callable& op) {
+  if constexpr (kUnsequenced && std::contiguous_iterator<Iter>) {
+    auto* p = std::to_address(first);
+    PARALLEL_FOREACH_VECTORIZE
+    for (std::size_t i = begin; i < end; ++i) {
+      op(p[i]);
+    }
+  } else {
+    auto it = std::next(first, static_cast<std::ptrdiff_t>(begin));
+    for (std::size_t i = begin; i < end; ++i, ++it) {
+      op(*it);
+    }
+  }
+}
+
+template <bool kUnsequenced, typename Iter, typename Callable>
+void parallel_run(Iter first, std::size_t n, std::size_t grain, Callable& op) {
+  auto& pool = ThreadPool::instance();
+  const std::size_t threads = pool.size() + 1;
+  std::size_t done = 0;
+  if (grain == 0) {
+    // 串行执行一小段, 估计每个元素的耗时
+    done = std::min(n, kProbe);
+    const auto start = std::chrono::steady_clock::now();
+    run_range<kUnsequenced>(first, 0, done, op);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    const std::int64_t per_element = std::max<std::int64_t>(1, ns / static_cast<std::int64_t>(std::max<std::size_t>(done, 1)));
+    grain = static_cast<std::size_t>(std::max<std::int64_t>(1, kTargetChunkNs / per_element));
+  }
+  if (threads == 1 || ThreadPool::in_worker() || n - done <= 2 * grain) {
+    run_range<kUnsequenced>(first, done, n, op);
+    return;
+  }
+
+  struct Shared {
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::exception_ptr error;
+  } shared;
+  shared.next.store(done, std::memory_order_relaxed);
+  // guided: 每次领取剩余的 1 / (2 * threads), 不少于 grain
+  auto grab = [&](std::size_t& begin, std::size_t& end) {
+    begin = shared.next.load(std::memory_order_relaxed);
+    do {
+      if (begin >= n) {
+        return false;
+      }
+      const std::size_t chunk = std::max(grain, (n - begin) / (2 * threads));
+      end = std::min(n, begin + chunk);
+    } while (!shared.next.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+    return true;
+  };
+  auto run = [&] {
+    try {
+      std::size_t begin = 0;
+      std::size_t end = 0;
+      while (!shared.failed.load(std::memory_order_relaxed) && grab(begin, end)) {
+        run_range<kUnsequenced>(first, begin, end, op);
+      }
+    } catch (...) {
+      std::lock_guard lock(shared.mutex);
+      if (!shared.error) {
+        shared.error = std::current_exception();
+      }
+      shared.failed.store(true, std::memory_order_relaxed);
+    }
+  };
+
+  const auto helpers = static_cast<std::ptrdiff_t>(std::min(threads - 1, (n - done) / grain - 1));
+  std::latch finished(helpers);
+  for (std::ptrdiff_t i = 0; i < helpers; ++i) {
+    pool.submit([&] {
+      run();
+      finished.count_down();
+    });
+  }
+  run();
+  finished.wait();
+  if (shared.error) {
+    std::rethrow_exception(shared.error);
+  }
+}
+
+}  // namespace detail
+
+template <ExecutionPolicy Policy, typename Iter, typename Callable>
+void foreach(const Policy& policy, Iter current, Iter end, Callable op) {
+  constexpr bool kRandomAccess = std::random_access_iterator<Iter>;
+  if constexpr (detail::is_parallel_v<Policy> && kRandomAccess) {
+    const auto n = static_cast<std::size_t>(std::distance(current, end));
+    detail::parallel_run<detail::is_unsequenced_v<Policy>>(current, n, policy.grain, op);
+  } else if constexpr (detail::is_unsequenced_v<Policy> && kRandomAccess) {
+    const auto n = static_cast<std::size_t>(std::distance(current, end));
+    detail::run_range<true>(current, 0, n, op);
+  } else {
+    while (current != end) {
+      op(*current);
+      ++current;
+    }
+  }
+}
+
+// 和 11.1.2 一样支持成员函数和额外的参数
+template <ExecutionPolicy Policy, typename Iter, typename Callable, typename... Args>
+void foreach(const Policy& policy, Iter current, Iter end, Callable op, const Args&... args) {
+  foreach(policy, current, end, [&](auto&& elem) {
+    std::invoke(op, args..., std::forward<decltype(elem)>(elem));
+  });
+}
+
+}  // namespace parallel
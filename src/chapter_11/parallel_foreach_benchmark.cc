@@ -0,0 +1,80 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 22:58:13
+# Desc   : 11.1 的串行 foreach 与 parallel::foreach(seq / unseq / par / par_unseq) 的对比
+########################################################################
+*/
+/*
+用法: chapter_11_parallel_foreach_benchmark [elements]
+1. 轻量的 op: x = x * a + b, 主要受内存带宽限制
+2. 重一些的 op: 每个元素做几十次整数哈希, 主要受计算限制, 并行的收益更明显
+3. 找到 TBB 时同时对比 std::for_each(std::execution::par, ...)(libstdc++ 的并行算法依赖 TBB)
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <vector>
+
+#ifdef CHAPTER_11_STD_EXECUTION_PAR
+#include <execution>
+#endif
+
+#include "utils/benchmark.h"
+
+#include "parallel_foreach.h"
+
+// 11.1.1 的串行版本
+template <typename Iter, typename Callable>
+void serial_foreach(Iter current, Iter end, Callable op) {
+  while (current != end) {
+    op(*current);
+    ++current;
+  }
+}
+
+template <typename T, typename Op>
+void bench(const char* title, std::vector<T>& v, Op op) {
+  const std::size_t n = v.size();
+  std::println("{}", title);
+  utils::run_benchmark("  serial foreach", n, [&] { serial_foreach(v.begin(), v.end(), op); utils::do_not_optimize(v); });
+  utils::run_benchmark("  parallel::seq", n, [&] { foreach(parallel::seq, v.begin(), v.end(), op); utils::do_not_optimize(v); });
+  utils::run_benchmark("  parallel::unseq", n, [&] { foreach(parallel::unseq, v.begin(), v.end(), op); utils::do_not_optimize(v); });
+  utils::run_benchmark("  parallel::par", n, [&] { foreach(parallel::par, v.begin(), v.end(), op); utils::do_not_optimize(v); });
+  utils::run_benchmark("  parallel::par_unseq", n, [&] { foreach(parallel::par_unseq, v.begin(), v.end(), op); utils::do_not_optimize(v); });
+#ifdef CHAPTER_11_STD_EXECUTION_PAR
+  utils::run_benchmark("  std::for_each(std::execution::par)", n, [&] {
+    std::for_each(std::execution::par, v.begin(), v.end(), op);
+    utils::do_not_optimize(v);
+  });
+#endif
+}
+
+int main(int argc, char** argv) {
+  const std::size_t elements = utils::arg_or(argc, argv, 1, 10'000'000);
+  std::println("elements: {}, thread pool workers: {}", elements, parallel::ThreadPool::instance().size());
+
+  std::vector<float> floats(elements, 1.0F);
+  bench("x = x * a + b", floats, [](float& x) { x = x * 0.999F + 0.001F; });
+
+  std::vector<std::uint64_t> ints(elements);
+  for (std::size_t i = 0; i < elements; ++i) {
+    ints[i] = i;
+  }
+  bench("32 rounds of integer hashing", ints, [](std::uint64_t& x) {
+    std::uint64_t h = x;
+    for (int r = 0; r < 32; ++r) {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+    }
+    x = h;
+  });
+  return 0;
+}
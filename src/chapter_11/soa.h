@@ -0,0 +1,298 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 01:05:52
+# Desc   : soa<Fields...>: 每个字段一个连续数组, 所有字段共享同一个 size 和 capacity
+########################################################################
+*/
+/*
+11.4 的 Arr<T, int& SZ> 让 vector 的长度依赖一个全局变量, 全局变量一变就越界
+"多个数组共享同一个长度" 的正确做法是把长度和这些数组放在同一个对象里, 由容器自己维护
+  columns::soa<float, float, int> s;  // 相当于 std::vector<struct { float x; float y; int id; }>, 但按列存储
+  s.push_back(1.0F, 2.0F, 3);
+1. 内存布局: 一次分配, 每一列的起始地址按 64 字节(cache line)对齐, 各列依次排列
+   column<I>() 返回第 I 列的 std::span, 只扫描一列时不会把其他字段读进 cache, 循环也容易向量化
+2. s[i] 返回 std::tuple<Fields&...>, 可以用 std::get<I> 或者结构化绑定访问一行, 赋值 s[i] = std::tuple{...} 修改整行
+   for (auto [x, y, id] : s) { x += y; }  // 按行迭代, x / y / id 都是引用
+3. 所有字段必须是 noexcept 可移动构造的, 扩容时逐列移动
+4. 迭代器的 operator* 返回的是临时的 tuple(代理对象), 所以只满足 input iterator 的要求, 不能用于 std::sort 等算法
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace columns {
+
+template <typename... Fields>
+class soa {
+  static_assert(sizeof...(Fields) > 0, "soa needs at least one field");
+  static_assert((std::is_nothrow_move_constructible_v<Fields> && ...), "soa fields must be nothrow move constructible");
+  static_assert((!std::is_reference_v<Fields> && ...), "soa fields can not be references");
+
+  using Indices = std::index_sequence_for<Fields...>;
+
+public:
+  static constexpr std::size_t kFields = sizeof...(Fields);
+  static constexpr std::size_t kAlignment = std::max({std::size_t{64}, alignof(Fields)...});
+
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields&...>;
+  using const_reference = std::tuple<const Fields&...>;
+  using size_type = std::size_t;
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  template <bool kConst>
+  class Iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = soa::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<kConst, soa::const_reference, soa::reference>;
+    using Owner = std::conditional_t<kConst, const soa, soa>;
+
+    Iterator() = default;
+    Iterator(Owner* owner, std::size_t index) : owner_(owner), index_(index) {}
+    // iterator 可以转换为 const_iterator
+    operator Iterator<true>() const requires(!kConst) { return {owner_, index_}; }
+
+    reference operator*() const { return (*owner_)[index_]; }
+    reference operator[](difference_type n) const { return (*owner_)[index_ + n]; }
+    Iterator& operator++() { ++index_; return *this; }
+    Iterator operator++(int) { auto old = *this; ++index_; return old; }
+    Iterator& operator--() { --index_; return *this; }
+    Iterator operator--(int) { auto old = *this; --index_; return old; }
+    Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+    Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+      return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.index_ == b.index_; }
+    friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.index_ <=> b.index_; }
+
+  private:
+    Owner* owner_{nullptr};
+    std::size_t index_{0};
+  };  // class Iterator
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  soa() = default;
+  explicit soa(std::size_t n) { resize(n); }
+  soa(const soa& other) { copy_from(other, Indices{}); }
+  soa(soa&& other) noexcept
+      : columns_(std::exchange(other.columns_, {})),
+        block_(std::exchange(other.block_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+  soa& operator=(soa other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~soa() {
+    clear();
+    deallocate(block_);
+  }
+
+  void swap(soa& other) noexcept {
+    std::swap(columns_, other.columns_);
+    std::swap(block_, other.block_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+  // 第 I 列
+  template <std::size_t I>
+  field_type<I>* data() { return std::get<I>(columns_); }
+  template <std::size_t I>
+  const field_type<I>* data() const { return std::get<I>(columns_); }
+  template <std::size_t I>
+  std::span<field_type<I>> column() { return {data<I>(), size_}; }
+  template <std::size_t I>
+  std::span<const field_type<I>> column() const { return {data<I>(), size_}; }
+
+  // 第 i 行
+  reference operator[](std::size_t i) {
+    return std::apply([i](auto*... column) { return reference(column[i]...); }, columns_);
+  }
+  const_reference operator[](std::size_t i) const {
+    return std::apply([i](auto*... column) { return const_reference(column[i]...); }, columns_);
+  }
+  reference front() { return (*this)[0]; }
+  reference back() { return (*this)[size_ - 1]; }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, size_}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, size_}; }
+
+  void reserve(std::size_t n) {
+    if (n > capacity_) {
+      reallocate(n, Indices{});
+    }
+  }
+
+  // 每一列用对应的一个实参构造
+  template <typename... Args>
+    requires(sizeof...(Args) == kFields)
+  void emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      emplace_back_grow(Indices{}, std::forward<Args>(args)...);
+      return;
+    }
+    construct_row(columns_, size_, Indices{}, std::forward<Args>(args)...);
+    ++size_;
+  }
+  void push_back(const Fields&... values) { emplace_back(values...); }
+  void push_back(Fields&&... values) { emplace_back(std::move(values)...); }
+  void push_back(const value_type& row) {
+    std::apply([this](const auto&... values) { emplace_back(values...); }, row);
+  }
+
+  void pop_back() {
+    --size_;
+    destroy_rows(size_, size_ + 1, Indices{});
+  }
+
+  // 新增的行值初始化
+  void resize(std::size_t n) {
+    if (n < size_) {
+      destroy_rows(n, size_, Indices{});
+      size_ = n;
+      return;
+    }
+    reserve(n);
+    while (size_ < n) {
+      emplace_back(Fields{}...);
+    }
+  }
+
+  void clear() {
+    destroy_rows(0, size_, Indices{});
+    size_ = 0;
+  }
+
+private:
+  static constexpr std::size_t align_up(std::size_t n) { return (n + kAlignment - 1) / kAlignment * kAlignment; }
+
+  // 第 I 列在内存块中的偏移, 最后一个元素是内存块的大小
+  static constexpr std::array<std::size_t, kFields + 1> layout(std::size_t capacity) {
+    constexpr std::array<std::size_t, kFields> sizes{sizeof(Fields)...};
+    std::array<std::size_t, kFields + 1> offsets{};
+    for (std::size_t i = 0; i < kFields; ++i) {
+      offsets[i + 1] = align_up(offsets[i] + sizes[i] * capacity);
+    }
+    return offsets;
+  }
+
+  static void deallocate(void* block) {
+    if (block != nullptr) {
+      ::operator delete(block, std::align_val_t{kAlignment});
+    }
+  }
+
+  // 分配能容纳 capacity 行的内存块, 返回内存块和各列的起始地址
+  template <std::size_t... I>
+  static std::pair<void*, std::tuple<Fields*...>> allocate(std::size_t capacity, std::index_sequence<I...>) {
+    const auto offsets = layout(capacity);
+    auto* block = static_cast<std::byte*>(::operator new(offsets[kFields], std::align_val_t{kAlignment}));
+    return {block, std::tuple<Fields*...>{reinterpret_cast<Fields*>(block + offsets[I])...}};
+  }
+
+  // 把已有的行移动到新的内存块(所有字段都是 noexcept 可移动构造的), 释放旧的内存块
+  template <std::size_t... I>
+  void adopt(void* block, const std::tuple<Fields*...>& columns, std::size_t capacity, std::index_sequence<I...>) {
+    (std::uninitialized_move(std::get<I>(columns_), std::get<I>(columns_) + size_, std::get<I>(columns)), ...);
+    destroy_rows(0, size_, Indices{});
+    deallocate(block_);
+    columns_ = columns;
+    block_ = block;
+    capacity_ = capacity;
+  }
+
+  void reallocate(std::size_t capacity, Indices indices) {
+    auto [block, columns] = allocate(capacity, indices);
+    adopt(block, columns, capacity, indices);
+  }
+
+  // 先在新的内存块中构造新的一行(args 可能引用已有的元素, 例如 s.push_back(s[0])), 再搬运已有的行
+  template <typename... Args>
+  void emplace_back_grow(Indices indices, Args&&... args) {
+    const std::size_t capacity = std::max<std::size_t>(16, 2 * capacity_);
+    auto [block, columns] = allocate(capacity, indices);
+    try {
+      construct_row(columns, size_, indices, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(block);
+      throw;
+    }
+    adopt(block, columns, capacity, indices);
+    ++size_;
+  }
+
+  // 在 columns 中构造第 row 行, 某一列的构造抛出异常时析构这一行已经构造好的列
+  template <std::size_t... I, typename... Args>
+  static void construct_row(
+      const std::tuple<Fields*...>& columns, std::size_t row, std::index_sequence<I...>, Args&&... args) {
+    std::size_t built = 0;
+    try {
+      ((std::construct_at(std::get<I>(columns) + row, std::forward<Args>(args)), ++built), ...);
+    } catch (...) {
+      ((I < built ? std::destroy_at(std::get<I>(columns) + row) : void()), ...);
+      throw;
+    }
+  }
+
+  template <std::size_t... I>
+  void destroy_rows(std::size_t first, std::size_t last, std::index_sequence<I...>) {
+    (std::destroy(std::get<I>(columns_) + first, std::get<I>(columns_) + last), ...);
+  }
+
+  template <std::size_t... I>
+  void copy_from(const soa& other, std::index_sequence<I...>) {
+    reserve(other.size_);
+    try {
+      for (std::size_t row = 0; row < other.size_; ++row) {
+        construct_row(columns_, row, Indices{}, std::get<I>(other.columns_)[row]...);
+        ++size_;
+      }
+    } catch (...) {
+      // 在构造函数中抛出异常时不会调用析构函数
+      clear();
+      deallocate(block_);
+      throw;
+    }
+  }
+
+  std::tuple<Fields*...> columns_{};
+  void* block_{nullptr};
+  std::size_t size_{0};
+  std::size_t capacity_{0};
+};  // class soa
+
+template <typename... Fields>
+void swap(soa<Fields...>& a, soa<Fields...>& b) noexcept {
+  a.swap(b);
+}
+
+}  // namespace columns
@@ -0,0 +1,102 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 01:37:14
+# Desc   : 按列扫描时 columns::soa 与 std::vector<struct> 的对比
+########################################################################
+*/
+/*
+用法: chapter_11_soa_benchmark [elements]
+粒子有 8 个 float 字段(32 字节), 三种访问方式:
+1. sum(x): 只读一列, AoS 每读 4 字节要把整个 32 字节的结构体读进 cache, SoA 只读需要的那一列
+2. x += vx * dt: 读两列写一列
+3. 按行访问全部字段(sum of all fields): 所有数据都要读, 两种布局的差距应该很小
+*/
+
+#include <cstddef>
+#include <print>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "soa.h"
+
+struct Particle {
+  float x, y, z;
+  float vx, vy, vz;
+  float mass;
+  float charge;
+};  // struct Particle
+
+using ParticleSoa = columns::soa<float, float, float, float, float, float, float, float>;
+enum Field { kX, kY, kZ, kVx, kVy, kVz, kMass, kCharge };
+
+UTILS_NOINLINE float sum_x(const std::vector<Particle>& v) {
+  float s = 0;
+  for (const auto& p : v) {
+    s += p.x;
+  }
+  return s;
+}
+UTILS_NOINLINE float sum_x(const ParticleSoa& v) {
+  float s = 0;
+  for (float x : v.column<kX>()) {
+    s += x;
+  }
+  return s;
+}
+
+UTILS_NOINLINE void advance(std::vector<Particle>& v, float dt) {
+  for (auto& p : v) {
+    p.x += p.vx * dt;
+  }
+}
+UTILS_NOINLINE void advance(ParticleSoa& v, float dt) {
+  auto x = v.column<kX>();
+  auto vx = v.column<kVx>();
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x[i] += vx[i] * dt;
+  }
+}
+
+UTILS_NOINLINE float sum_all(const std::vector<Particle>& v) {
+  float s = 0;
+  for (const auto& p : v) {
+    s += p.x + p.y + p.z + p.vx + p.vy + p.vz + p.mass + p.charge;
+  }
+  return s;
+}
+UTILS_NOINLINE float sum_all(const ParticleSoa& v) {
+  float s = 0;
+  for (const auto& [x, y, z, vx, vy, vz, mass, charge] : v) {
+    s += x + y + z + vx + vy + vz + mass + charge;
+  }
+  return s;
+}
+
+int main(int argc, char** argv) {
+  const std::size_t elements = utils::arg_or(argc, argv, 1, 4'000'000);
+  std::vector<Particle> aos;
+  ParticleSoa soa;
+  aos.reserve(elements);
+  soa.reserve(elements);
+  for (std::size_t i = 0; i < elements; ++i) {
+    const auto f = static_cast<float>(i % 100) * 0.01F;
+    aos.push_back({f, f, f, 1.0F, 1.0F, 1.0F, 1.0F, 0.0F});
+    soa.push_back(f, f, f, 1.0F, 1.0F, 1.0F, 1.0F, 0.0F);
+  }
+
+  std::println("elements: {}, sizeof(Particle) = {}", elements, sizeof(Particle));
+  utils::run_benchmark("sum(x), vector<struct>", elements, [&] { utils::do_not_optimize(sum_x(aos)); });
+  utils::run_benchmark("sum(x), soa", elements, [&] { utils::do_not_optimize(sum_x(soa)); });
+  utils::run_benchmark("x += vx * dt, vector<struct>", elements, [&] { advance(aos, 0.001F); });
+  utils::run_benchmark("x += vx * dt, soa", elements, [&] { advance(soa, 0.001F); });
+  utils::run_benchmark("sum of all fields, vector<struct>", elements, [&] { utils::do_not_optimize(sum_all(aos)); });
+  utils::run_benchmark("sum of all fields, soa (zipped)", elements, [&] { utils::do_not_optimize(sum_all(soa)); });
+  return 0;
+}
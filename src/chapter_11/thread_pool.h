@@ -0,0 +1,53 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 22:10:35
+# Desc   : 固定大小的线程池, parallel::foreach 的后端
+########################################################################
+*/
+/*
+1. instance() 是进程内共享的线程池, hardware_concurrency() - 1 个工作线程, 调用者自己作为最后一个线程参与计算
+2. 任务按提交顺序执行, 析构时先执行完队列中剩余的任务再退出
+3. in_worker(): 当前线程是否是线程池的工作线程
+   工作线程中如果再等待提交给同一个线程池的任务, 在所有工作线程都在等待时会死锁, 所以嵌套的并行调用应该串行执行
+*/
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+class ThreadPool {
+public:
+  explicit ThreadPool(unsigned threads);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  static ThreadPool& instance();
+  static bool in_worker();
+
+  void submit(std::function<void()> task);
+  unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+private:
+  void work();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+};  // class ThreadPool
+
+}  // namespace parallel
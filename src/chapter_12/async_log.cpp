@@ -0,0 +1,211 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 13:58:40
+# Desc   :
+########################################################################
+*/
+
+#include "async_log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace logging {
+
+namespace detail {
+
+Ring::Ring() : buffer_(std::make_unique_for_overwrite<std::byte[]>(kRingBytes)) {}
+
+void Ring::wait_for_space(std::uint64_t end) {
+  while (end - (cached_tail_ = tail_.load(std::memory_order_acquire)) > kRingBytes) {
+    std::this_thread::yield();
+  }
+}
+
+bool Ring::drain(std::string& out) {
+  std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const std::uint64_t head = head_.load(std::memory_order_acquire);
+  if (tail == head) {
+    return false;
+  }
+  while (tail != head) {
+    const std::size_t pos = tail & (kRingBytes - 1);
+    RecordHeader header;
+    std::memcpy(&header.size, buffer_.get() + pos, sizeof(header.size));
+    if (header.size == 0) {
+      tail += kRingBytes - pos;
+      continue;
+    }
+    std::memcpy(&header, buffer_.get() + pos, sizeof(header));
+    header.decode(std::string_view(header.fmt, header.fmt_size), buffer_.get() + pos + sizeof(header), out);
+    tail += header.size;
+  }
+  tail_.store(tail, std::memory_order_release);
+  return true;
+}
+
+namespace {
+
+class Logger {
+public:
+  static Logger& instance() {
+    static Logger logger;
+    return logger;
+  }
+
+  Ring& add(std::shared_ptr<Ring> ring) {
+    std::lock_guard lock(mutex_);
+    rings_.push_back(ring);
+    return *ring;
+  }
+
+  bool open(const char* path) {
+    const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      return false;
+    }
+    flush();
+    std::lock_guard lock(mutex_);
+    // 后台线程这一轮可能还在向旧的 fd 写入, 由它在这一轮结束时关闭
+    if (fd_ != STDOUT_FILENO) {
+      retired_fds_.push_back(fd_);
+    }
+    fd_ = fd;
+    return true;
+  }
+
+  // 等待后台线程完成一轮在此之后开始的读取
+  void flush() {
+    std::unique_lock lock(mutex_);
+    const std::uint64_t ticket = ++flush_requested_;
+    wake_.notify_one();
+    flushed_cv_.wait(lock, [&] { return flushed_ >= ticket; });
+  }
+
+private:
+  Logger() : worker_([this] { run(); }) {}
+  ~Logger() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+    if (fd_ != STDOUT_FILENO) {
+      ::close(fd_);
+    }
+  }
+
+  void run() {
+    std::string batch;
+    batch.reserve(kBatchBytes * 2);
+    std::vector<std::shared_ptr<Ring>> rings;
+    for (;;) {
+      std::uint64_t ticket;
+      bool stop;
+      int fd;
+      {
+        std::lock_guard lock(mutex_);
+        // 已经退出的线程: 读完之后释放它的缓冲区
+        std::erase_if(rings_, [](const auto& ring) { return ring->closed() && ring->empty(); });
+        rings = rings_;
+        ticket = flush_requested_;
+        stop = stop_;
+        fd = fd_;
+      }
+      bool busy = false;
+      for (const auto& ring : rings) {
+        busy |= ring->drain(batch);
+        if (batch.size() >= kBatchBytes) {
+          write_all(fd, batch);
+        }
+      }
+      write_all(fd, batch);
+
+      std::unique_lock lock(mutex_);
+      // 这一轮之后的读取都使用新的 fd_, 被替换的 fd 不会再被用到
+      for (const int retired : retired_fds_) {
+        ::close(retired);
+      }
+      retired_fds_.clear();
+      if (flushed_ < ticket) {
+        flushed_ = ticket;
+        flushed_cv_.notify_all();
+      }
+      if (stop && !busy) {
+        return;
+      }
+      if (!busy && flush_requested_ == flushed_) {
+        wake_.wait_for(lock, std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  static void write_all(int fd, std::string& batch) {
+    std::size_t done = 0;
+    while (done < batch.size()) {
+      const ssize_t n = ::write(fd, batch.data() + done, batch.size() - done);
+      if (n <= 0) {
+        break;
+      }
+      done += static_cast<std::size_t>(n);
+    }
+    batch.clear();
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable flushed_cv_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+  std::uint64_t flush_requested_{0};
+  std::uint64_t flushed_{0};
+  bool stop_{false};
+  int fd_{STDOUT_FILENO};
+  std::vector<int> retired_fds_;  // open 替换下来的 fd, 等待后台线程关闭
+  std::thread worker_;
+};  // class Logger
+
+// 线程退出时标记缓冲区已关闭, 由后台线程读完后释放
+struct RingOwner {
+  std::shared_ptr<Ring> ring;
+  ~RingOwner() {
+    if (ring != nullptr) {
+      ring->close();
+      t_ring = nullptr;
+    }
+  }
+};  // struct RingOwner
+
+thread_local RingOwner t_owner;
+
+}  // namespace
+
+Ring& register_thread() {
+  t_owner.ring = std::make_shared<Ring>();
+  return Logger::instance().add(t_owner.ring);
+}
+
+}  // namespace detail
+
+bool open(const char* path) {
+  return detail::Logger::instance().open(path);
+}
+
+void flush() {
+  detail::Logger::instance().flush();
+}
+
+}  // namespace logging
@@ -0,0 +1,218 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 13:26:15
+# Desc   : logging::log(fmt, args...): 异步的二进制日志, 调用线程只复制参数的字节
+########################################################################
+*/
+/*
+std::println 在调用线程上完成格式化和 write, 一条日志通常要几百纳秒, 缓冲区满时还要等一次系统调用
+logging::log 把这些工作都交给后台线程:
+1. 调用线程只把 "解码函数 + 格式串 + 参数的原始字节" 写入自己的环形缓冲区, 不格式化, 不加锁, 不分配内存
+   格式串必须是编译期常量(和 std::format_string 一样在编译期检查), 所以直接用它的地址作为格式串的 id
+   解码函数是 decode<Args...> 的实例, 它知道每个参数的类型, 后台线程用它把字节还原为参数再格式化
+2. 每个线程一个单生产者单消费者的环形缓冲区(默认 kRingBytes), 第一次 log 时登记; 线程退出后缓冲区由后台线程读完再释放
+   一条记录必须连续存放, 缓冲区尾部放不下时写一个长度为 0 的标记, 从头开始
+   缓冲区满时调用线程自旋等待(不丢日志)
+3. 参数支持算术类型和字符串(const char*、std::string、std::string_view、字符数组)
+   算术类型按 memcpy 保存; 字符串保存长度 + 内容, 超过 kMaxString 的部分被截断
+4. 后台线程轮询所有缓冲区, 格式化的结果攒到 kBatchBytes 或者缓冲区都读空时才 write 一次
+   默认输出到标准输出(fd 1), open(path) 改为输出到文件; flush() 等待此前写入的日志全部 write 完
+5. 同一个线程的日志保持顺序, 不同线程之间的顺序不保证
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace logging {
+
+inline constexpr std::size_t kRingBytes = std::size_t{1} << 20;
+inline constexpr std::size_t kMaxString = 4096;
+inline constexpr std::size_t kBatchBytes = std::size_t{64} << 10;
+
+// 日志输出到文件 path(截断), 返回是否成功
+bool open(const char* path);
+// 等待当前线程此前写入的日志全部输出
+void flush();
+
+namespace detail {
+
+// 字符串类的参数
+template <typename T>
+concept StringLike = std::convertible_to<const T&, std::string_view>;
+
+template <typename T>
+concept Trivial = std::is_arithmetic_v<T> || std::same_as<T, const void*> || std::same_as<T, void*>;
+
+// 参数在缓冲区中的编码, 以及后台线程解码得到的类型
+template <typename T>
+struct Codec;
+
+template <Trivial T>
+struct Codec<T> {
+  using stored_type = T;
+  static std::size_t size(const T&) { return sizeof(T); }
+  static std::byte* encode(std::byte* p, const T& value) {
+    std::memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+  }
+  static T decode(const std::byte*& p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+  }
+};  // struct Codec<Trivial>
+
+template <StringLike T>
+  requires(!Trivial<T>)
+struct Codec<T> {
+  using stored_type = std::string_view;
+  static std::size_t length(const T& value) {
+    return std::min(std::string_view(value).size(), kMaxString);
+  }
+  static std::size_t size(const T& value) { return sizeof(std::uint32_t) + length(value); }
+  static std::byte* encode(std::byte* p, const T& value) {
+    const auto n = static_cast<std::uint32_t>(length(value));
+    std::memcpy(p, &n, sizeof(n));
+    std::memcpy(p + sizeof(n), std::string_view(value).data(), n);
+    return p + sizeof(n) + n;
+  }
+  static std::string_view decode(const std::byte*& p) {
+    std::uint32_t n;
+    std::memcpy(&n, p, sizeof(n));
+    std::string_view value(reinterpret_cast<const char*>(p + sizeof(n)), n);
+    p += sizeof(n) + n;
+    return value;
+  }
+};  // struct Codec<StringLike>
+
+template <typename T>
+using stored_t = typename Codec<std::remove_cvref_t<T>>::stored_type;
+
+// 把参数字节还原为参数, 格式化后追加到 out 中
+using Decoder = void (*)(std::string_view fmt, const std::byte* args, std::string& out);
+
+template <typename... Args>
+void decode(std::string_view fmt, const std::byte* args, std::string& out) {
+  // 花括号初始化按从左到右的顺序求值
+  std::tuple<typename Codec<Args>::stored_type...> values{Codec<Args>::decode(args)...};
+  std::apply([&](auto&... v) { std::vformat_to(std::back_inserter(out), fmt, std::make_format_args(v...)); }, values);
+  out.push_back('\n');
+}
+
+struct RecordHeader {
+  std::uint32_t size;  // 整条记录的字节数(8 字节对齐), 0 表示跳到缓冲区开头
+  std::uint32_t fmt_size;
+  Decoder decode;
+  const char* fmt;
+};  // struct RecordHeader
+
+// 单生产者(所属线程)单消费者(后台线程)的环形缓冲区
+// head_ / tail_ 是单调递增的字节数, 对容量取模得到位置
+class Ring {
+public:
+  Ring();
+
+  // 预留连续的 n 个字节(n 是 8 的倍数), 空间不够时等待后台线程读取
+  std::byte* reserve(std::size_t n) {
+    std::uint64_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t pos = head & (kRingBytes - 1);
+    const std::size_t skip = kRingBytes - pos < n ? kRingBytes - pos : 0;
+    if (head + skip + n - cached_tail_ > kRingBytes) [[unlikely]] {
+      wait_for_space(head + skip + n);
+    }
+    if (skip != 0) {
+      const std::uint32_t wrap = 0;
+      std::memcpy(buffer_.get() + pos, &wrap, sizeof(wrap));
+      head += skip;
+    }
+    reserved_ = head + n;
+    return buffer_.get() + (head & (kRingBytes - 1));
+  }
+  void commit() { head_.store(reserved_, std::memory_order_release); }
+
+  // 由后台线程调用, 解码所有已提交的记录, 返回是否读到了记录
+  bool drain(std::string& out);
+  void close() { closed_.store(true, std::memory_order_release); }
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void wait_for_space(std::uint64_t end);
+
+  std::unique_ptr<std::byte[]> buffer_;
+  // 生产者使用
+  alignas(64) std::atomic<std::uint64_t> head_{0};
+  std::uint64_t cached_tail_{0};
+  std::uint64_t reserved_{0};
+  // 消费者使用
+  alignas(64) std::atomic<std::uint64_t> tail_{0};
+  std::atomic<bool> closed_{false};
+};  // class Ring
+
+// 当前线程的缓冲区, 第一次调用时向后台线程登记
+Ring& register_thread();
+inline thread_local Ring* t_ring = nullptr;
+inline Ring& local_ring() {
+  if (t_ring == nullptr) [[unlikely]] {
+    t_ring = &register_thread();
+  }
+  return *t_ring;
+}
+
+}  // namespace detail
+
+// 编译期检查格式串, 检查时字符串参数都按 std::string_view 处理, 和后台线程格式化时一致
+template <typename... Args>
+class Format {
+public:
+  template <typename S>
+    requires std::convertible_to<const S&, std::string_view>
+  consteval Format(const S& fmt) : fmt_(fmt) {
+    static_cast<void>(std::format_string<detail::stored_t<Args>...>(fmt));
+  }
+  std::string_view get() const { return fmt_; }
+
+private:
+  std::string_view fmt_;
+};  // class Format
+
+template <typename... Args>
+void log(Format<std::type_identity_t<Args>...> fmt, const Args&... args) {
+  using detail::Codec;
+  using detail::RecordHeader;
+  const std::size_t size =
+      ((sizeof(RecordHeader) + ... + Codec<std::remove_cvref_t<Args>>::size(args)) + 7) & ~std::size_t{7};
+  assert(size <= kRingBytes / 2);
+  detail::Ring& ring = detail::local_ring();
+  std::byte* p = ring.reserve(size);
+  const RecordHeader header{static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(fmt.get().size()),
+      &detail::decode<std::remove_cvref_t<Args>...>, fmt.get().data()};
+  std::memcpy(p, &header, sizeof(header));
+  p += sizeof(header);
+  ((p = Codec<std::remove_cvref_t<Args>>::encode(p, args)), ...);
+  ring.commit();
+}
+
+}  // namespace logging
@@ -0,0 +1,93 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 14:31:52
+# Desc   : logging::log 与 std::println 写文件的单次调用延迟对比
+########################################################################
+*/
+/*
+用法: chapter_12_async_log_benchmark [messages] [path_prefix]
+每条日志: "order {} price {:.2f} qty {} side {}", 参数是 uint64、double、int、字符串
+1. std::println(FILE*, ...): 调用线程格式化, 写入 stdio 的缓冲区, 缓冲区满时在调用线程上 write
+2. logging::log: 调用线程只把参数字节写入环形缓冲区
+每 kBurst 条日志之后调用一次 flush(不计时), 模拟突发的日志, 不让环形缓冲区写满后的等待混入调用延迟
+每次调用前后各读一次 rdtsc, 用 chapter_11 的 latency::Histogram 统计 p50 / p99 / p999, 结果中包含计时本身的开销
+目标: logging::log 的 p99 低于 100 ns
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <print>
+#include <string>
+#include <string_view>
+
+#include "chapter_11/latency_histogram.h"
+#include "utils/benchmark.h"
+
+#include "async_log.h"
+
+inline constexpr std::size_t kBurst = 4096;
+
+template <typename Log, typename Flush>
+void measure(std::string_view name, std::size_t messages, Log log, Flush flush) {
+  latency::Histogram histogram;
+  utils::Stopwatch watch;
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < messages; ++i) {
+    const std::uint64_t start = latency::cycle_now();
+    log(i);
+    const std::uint64_t cycles = latency::cycle_now() - start;
+    histogram.record(cycles);
+    total += cycles;
+    if ((i + 1) % kBurst == 0) {
+      flush();
+    }
+  }
+  flush();
+  const double ns = latency::ns_per_cycle();
+  std::println("{:<24} mean {:>8.1f} ns  p50 {:>8.1f} ns  p99 {:>8.1f} ns  p999 {:>8.1f} ns  wall (with flush) {:>8.1f} ns/msg",
+      name, static_cast<double>(total) * ns / static_cast<double>(messages),
+      static_cast<double>(histogram.percentile(0.5)) * ns, static_cast<double>(histogram.percentile(0.99)) * ns,
+      static_cast<double>(histogram.percentile(0.999)) * ns, watch.elapsed_ns() / static_cast<double>(messages));
+}
+
+int main(int argc, char** argv) {
+  const std::size_t messages = utils::arg_or(argc, argv, 1, 1'000'000);
+  const std::string prefix = argc > 2 ? argv[2] : "/tmp/chapter_12_async_log_benchmark";
+  const std::string side = "buy";
+  std::println("messages: {}, ns per cycle: {:.4f}", messages, latency::ns_per_cycle());
+
+  measure("rdtsc only", messages, [](std::size_t) {}, [] {});
+
+  const std::string println_path = prefix + ".println.log";
+  std::FILE* file = std::fopen(println_path.c_str(), "w");
+  if (file == nullptr) {
+    std::println("cannot open {}", println_path);
+    return 1;
+  }
+  measure("std::println(FILE*)", messages,
+      [&](std::size_t i) {
+        std::println(file, "order {} price {:.2f} qty {} side {}", i, 100.0 + static_cast<double>(i % 100) * 0.25,
+            static_cast<int>(i % 1000), side);
+      },
+      [&] { std::fflush(file); });
+  std::fclose(file);
+
+  if (!logging::open((prefix + ".async.log").c_str())) {
+    std::println("cannot open {}.async.log", prefix);
+    return 1;
+  }
+  measure("logging::log", messages,
+      [&](std::size_t i) {
+        logging::log("order {} price {:.2f} qty {} side {}", i, 100.0 + static_cast<double>(i % 100) * 0.25,
+            static_cast<int>(i % 1000), side);
+      },
+      [] { logging::flush(); });
+  return 0;
+}
@@ -11,9 +11,23 @@
 ########################################################################
 */
 
+#include <cassert>
+#include <cstdio>
+#include <memory>
 #include <print>
+#include <string>
+#include <thread>
+#include <vector>
 #include "cpp_utils/util.h"
 
+#include "async_log.h"
+#include "object_pool.h"
+#include "poly_value.h"
+#include "relocate.h"
+#include "sharded_counter.h"
+#include "slot_map.h"
+#include "typed_arena.h"
+
 // 12.1 参数化的声明
 // C++ 模板: 类模板、函数模板、变量模板、别名模板
 // 其可以被定义在命名空间作用域(namespace scope)和类作用域(class scope)
@@ -27,9 +41,10 @@ public:
 };  // class Data
 
 // 函数模板的命名空间
+// 只把参数的字节写入当前线程的缓冲区, 由后台线程格式化并输出, 见 async_log.h
 template <typename T>
 void log(T x) {
-
+  logging::log("{}", x);
 }
 
 // 变量模板的命名空间 (从 C++14 开始)
@@ -45,6 +60,17 @@ template <typename T>
 using DataList = Data<T*>;
 
 
+void run_log() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  // 日志由后台线程直接 write 到 fd 1, 先把 stdout 中缓冲的内容输出, 保持顺序
+  std::fflush(stdout);
+  log(42);
+  log("a string literal");
+  logging::log("order {} price {:.2f} side {}", 1001, 99.5, std::string("buy"));
+  logging::flush();
+  std::println();
+}
+
 class Collection {
 public:
   // 类内部成员类模板的定义
@@ -53,9 +79,18 @@ public:
   };  // class Node
 
   // 类内部(隐式内联)
+  // 每种类型在 arena_ 中有自己的 slab, 线程内无锁分配, 见 typed_arena.h
   template <typename T>
   T* alloc() {
-    return nullptr;
+    return arena_.alloc<T>();
+  }
+  template <typename T>
+  void dealloc(T* p) {
+    arena_.dealloc(p);
+  }
+  // 一次释放所有分配的内存
+  void reset() {
+    arena_.reset();
   }
 
   // 成员变量模板(从 C++14 开始)
@@ -65,8 +100,28 @@ public:
   // 成员别名模板
   template <typename T>
   using NodePtr = Node<T>*;
+
+private:
+  arena::Arena arena_;
 };  // class Collection
 
+void run_collection() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  Collection c;
+  int* i = c.alloc<int>();
+  double* d = c.alloc<double>();
+  *i = 1;
+  *d = 2.0;
+  assert(reinterpret_cast<void*>(i) != reinterpret_cast<void*>(d));
+  // 释放后, 同一个线程再分配同一类型时优先复用刚释放的 slot
+  c.dealloc(i);
+  int* reused = c.alloc<int>();
+  assert(reused == i);
+  c.reset();  // i 和 d 都失效了
+  std::println("alloc<int>() after reset: {}", static_cast<void*>(c.alloc<int>()));
+  std::println();
+}
+
 
 template <typename T>
 class List {
@@ -98,6 +153,35 @@ template <typename T>
 template <typename U>
 U List<T>::zero = 0;
 
+// 同样结构的 List 的一个完整实现: Handle<U> 是 下标 + generation, 元素紧密存放, 见 slot_map.h
+void run_slot_list() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  slot::List<int> list;
+  auto a = list.insert(1);
+  auto b = list.insert(2);
+  auto c = list.insert(3);
+  const bool erased = list.erase(a);  // 3 被移动到了 1 原来的位置
+  assert(erased);
+  assert(!list.contains(a) && list.get(a) == nullptr && !list.erase(a));
+  assert(list[b] == 2 && list[c] == 3);
+  auto d = list.insert(4);  // 复用 a 的 slot, 但 generation 不同
+  assert(d.index() == a.index() && d != a && !list.contains(a));
+
+  slot::List<int>::const_handle cb = b;
+  slot::List<double> doubles(list);  // 构造函数模板: 逐个转换元素, slot 保持不变
+  assert(doubles.size() == list.size() && doubles.data()[0] == 3.0);
+  // 原来的 handle 通过 rebind 转换后在新的 List 中仍然有效
+  assert(doubles[doubles.rebind<int>(b)] == 2.0 && doubles[doubles.rebind<int>(cb)] == 2.0);
+  assert(!doubles.contains(doubles.rebind<int>(a)));
+  int sum = 0;
+  for (int v : list) {
+    sum += v;
+  }
+  assert(sum == 9 && list[cb] == 2);
+  std::println("size = {}, sum = {}", list.size(), sum);
+  std::println();
+}
+
 // 联合模板
 template <typename T>
 union AllocChunk {
@@ -114,6 +198,23 @@ void run_union() {
   std::println();
 }
 
+// AllocChunk 的对象和字节重叠的布局, 正好可以作为空闲链表对象池的存储单元, 见 object_pool.h
+void run_object_pool() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  pool::ObjectPool<std::string> strings;
+  std::string* a = strings.construct("hello");
+  std::string* b = strings.construct(3, 'x');
+  assert(*a == "hello" && *b == "xxx" && strings.size() == 2);
+  strings.destroy(a);
+  // 刚释放的单元在链表头部, 马上被复用
+  std::string* c = strings.construct("world");
+  assert(c == a);
+  strings.destroy(b);
+  strings.destroy(c);
+  std::println("size = {}, capacity = {}", strings.size(), strings.capacity());
+  std::println();
+}
+
 template <typename T>
 class Stack;
 template <typename T>
@@ -136,6 +237,54 @@ void init(Array<Value>& array) {
   // fill(array);
 }
 
+// 上面声明的 Stack<T>, 元素保存在 reloc::Vector 中, 扩容时可平凡重定位的元素直接 memcpy, 见 relocate.h
+template <typename T>
+class Stack {
+public:
+  void push(T elem) { elems_.push_back(std::move(elem)); }
+  void pop() { elems_.pop_back(); }
+  const T& top() const { return elems_.back(); }
+  bool empty() const { return elems_.empty(); }
+  std::size_t size() const { return elems_.size(); }
+
+private:
+  reloc::Vector<T> elems_;
+};  // class Stack
+
+// 和 data_copyable<T> 一样, 通过特化类模板的静态成员声明类型的性质
+struct Widget {
+  std::unique_ptr<int> id;
+  double weight;
+};  // struct Widget
+template <>
+struct reloc::Relocatable<Widget> {
+  static constexpr bool trivially = true;
+};  // struct reloc::Relocatable<Widget>
+
+void run_stack() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  static_assert(Data<int>::copyable && reloc::is_trivially_relocatable<int>);
+  static_assert(reloc::is_trivially_relocatable<std::unique_ptr<int>> && reloc::is_trivially_relocatable<Widget>);
+  static_assert(!reloc::is_trivially_relocatable<std::string>);
+  Stack<Widget> widgets;
+  for (int i = 0; i < 100; ++i) {
+    widgets.push({std::make_unique<int>(i), i * 0.5});
+  }
+  assert(*widgets.top().id == 99);
+  Stack<std::string> strings;
+  for (int i = 0; i < 100; ++i) {
+    strings.push(std::to_string(i));
+  }
+  strings.pop();
+  reloc::Vector<std::unique_ptr<int>> v;
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(std::make_unique<int>(i));
+  }
+  v.erase(v.begin() + 2, v.begin() + 5);
+  std::println("widgets: {}, strings.top() = {}, v[2] = {}", widgets.size(), strings.top(), *v[2]);
+  std::println();
+}
+
 // 类模版中的非模板成员
 template <int I>
 class CupBoard {
@@ -146,6 +295,10 @@ class CupBoard {
 
   // C++17 开始，可以使用 inline 关键字在类模板内初始化静态成员
   inline static double total_weight_2{0.0};
+
+public:
+  // 多个线程同时累加的静态成员, 每个 CPU 一个槽位, 见 sharded_counter.h
+  inline static sharded::sharded_counter<double> total_weight_3;
 };  // class CupBoard
 
 template <int I>
@@ -160,6 +313,25 @@ enum CupBoard<I>::Wood : unsigned char {
 template <int I>
 double CupBoard<I>::total_weight = 0.0;
 
+void run_cupboard() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 1000; ++i) {
+        CupBoard<1>::total_weight_3 += 0.5;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  // 每个 CupBoard<I> 的实例有自己的静态成员
+  assert(CupBoard<2>::total_weight_3.load() == 0.0);
+  std::println("CupBoard<1>::total_weight_3 = {}", CupBoard<1>::total_weight_3.load());
+  std::println();
+}
+
 //  12.1.1 虚成员函数
 // 成员函数模板不能被声明为虚函数(因为无法确定虚函数表的大小)
 template <typename T>
@@ -172,6 +344,27 @@ public:
   // virtual void copy(const T2&);
 };  // class Dynamic
 
+// 不能有虚成员函数模板, 但可以在构造时为具体的类型生成一张函数表(类型擦除), 见 poly_value.h
+void run_poly_value() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  // Signature 为 void 时只保存值, 相当于 std::any
+  poly::poly_value<> value = 42;
+  poly::poly_value<> copy = value;
+  assert(*copy.target<int>() == 42 && copy.target<double>() == nullptr);
+  value = std::string("longer than the small string buffer of std::string");
+  copy = value;
+  assert(*copy.target<std::string>() == *value.target<std::string>());
+  assert(copy.is_inline() && *value.target<std::string>() != "");
+
+  // 捕获 40 字节的 lambda, std::function 需要分配堆内存, poly_value 不需要
+  double a = 1, b = 2, c = 3, d = 4, e = 5;
+  poly::poly_value<double(double)> f = [a, b, c, d, e](double x) { return (((e * x + d) * x + c) * x + b) * x + a; };
+  auto g = f;
+  assert(f.is_inline() && g.is_inline());
+  std::println("f(1) = {}, g(2) = {}", f(1), g(2));
+  std::println();
+}
+
 // 12.1.2 模板的链接
 int C;
 class C;  // OK: 类名字和非类名字不在同一个空间
@@ -758,7 +951,14 @@ void run_creator() {
 // 12.5.3 友元模板
 
 int main() {
+  run_log();
+  run_collection();
   run_union();
+  run_object_pool();
+  run_stack();
+  run_cupboard();
+  run_slot_list();
+  run_poly_value();
   run_decay();
   run_counter();
   run_parameter();
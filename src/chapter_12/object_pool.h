@@ -0,0 +1,140 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 10:38:22
+# Desc   : pool::ObjectPool<T>: 以联合模板 AllocChunk<T> 作为存储单元的定长对象池
+########################################################################
+*/
+/*
+12.1 的联合模板 AllocChunk<T> 让 T object 和 bytes[sizeof(T)] 共享同一块内存, 这正是侵入式空闲链表的单元:
+  使用中: 单元里是 T object
+  空闲时: 单元的开头保存下一个空闲单元的指针 next
+1. construct(args...) 从空闲链表头部取一个单元并构造对象, destroy(p) 析构对象并把单元放回链表头部, 都是 O(1)
+2. 空闲链表为空时按块增长: 第一块 kFirstChunk 个单元, 之后每块翻倍, 最多 kMaxChunk 个
+   稳定状态下(活跃对象数不再增长)不会再向系统申请内存
+3. kPoison 为 true 时(默认在没有定义 NDEBUG 时开启):
+   destroy 后用 kPoisonByte 填充单元(next 指针之外的部分), construct 时检查填充是否被改写, 用于发现释放后写入的错误
+4. 对象池析构时只释放内存, 不会析构仍然存活的对象; 开启 kPoison 时会断言所有对象都已经 destroy
+*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace pool {
+
+#ifdef NDEBUG
+inline constexpr bool kPoisonByDefault = false;
+#else
+inline constexpr bool kPoisonByDefault = true;
+#endif
+inline constexpr unsigned char kPoisonByte = 0xDD;
+
+// 12.1 的 AllocChunk<T> 加上空闲时使用的 next 指针
+template <typename T>
+union AllocChunk {
+  T object;
+  unsigned char bytes[sizeof(T)];
+  AllocChunk* next;
+
+  // 不构造也不析构 object, 由 ObjectPool 管理
+  AllocChunk() {}
+  ~AllocChunk() {}
+};  // union AllocChunk
+
+template <typename T, bool kPoison = kPoisonByDefault>
+class ObjectPool {
+  using Chunk = AllocChunk<T>;
+
+public:
+  static constexpr std::size_t kFirstChunk = 64;
+  static constexpr std::size_t kMaxChunk = 64 * 1024;
+
+  ObjectPool() = default;
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+  ~ObjectPool() {
+    if constexpr (kPoison) {
+      assert(live_ == 0 && "pool::ObjectPool destroyed with live objects");
+    }
+  }
+
+  template <typename... Args>
+  T* construct(Args&&... args) {
+    if (free_ == nullptr) [[unlikely]] {
+      grow();
+    }
+    Chunk* cell = free_;
+    if constexpr (kPoison) {
+      check_poison(cell);
+    }
+    free_ = cell->next;
+    try {
+      T* p = std::construct_at(&cell->object, std::forward<Args>(args)...);
+      ++live_;
+      return p;
+    } catch (...) {
+      release(cell);
+      throw;
+    }
+  }
+
+  // p 必须是这个对象池 construct 返回的
+  void destroy(T* p) {
+    if (p == nullptr) {
+      return;
+    }
+    std::destroy_at(p);
+    --live_;
+    // object 是联合的第一个成员, 和联合本身的地址相同
+    release(reinterpret_cast<Chunk*>(p));
+  }
+
+  std::size_t size() const { return live_; }
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  void release(Chunk* cell) {
+    if constexpr (kPoison) {
+      std::memset(static_cast<void*>(cell), kPoisonByte, sizeof(Chunk));
+    }
+    cell->next = free_;
+    free_ = cell;
+  }
+
+  static void check_poison(const Chunk* cell) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(cell);
+    for (std::size_t i = sizeof(Chunk*); i < sizeof(Chunk); ++i) {
+      assert(bytes[i] == kPoisonByte && "pool::ObjectPool: free cell modified after destroy");
+    }
+  }
+
+  void grow() {
+    const std::size_t n = chunks_.empty() ? kFirstChunk : std::min(kMaxChunk, capacity_);
+    auto chunk = std::make_unique<Chunk[]>(n);
+    // 按地址顺序链接, 先分配到的对象在内存中相邻
+    for (std::size_t i = n; i-- > 0;) {
+      release(&chunk[i]);
+    }
+    capacity_ += n;
+    chunks_.push_back(std::move(chunk));
+  }
+
+  Chunk* free_{nullptr};
+  std::size_t live_{0};
+  std::size_t capacity_{0};
+  std::vector<std::unique_ptr<Chunk[]>> chunks_;
+};  // class ObjectPool
+
+}  // namespace pool
@@ -0,0 +1,100 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 11:02:45
+# Desc   : pool::ObjectPool 与全局 new / delete 的分配释放对比
+########################################################################
+*/
+/*
+用法: chapter_12_object_pool_benchmark [cycles]
+默认 10M 次分配 + 释放, 对象是 48 字节的结构体
+1. 立即释放: 每次 construct 之后马上 destroy, 空闲链表的头部一直是同一个单元
+2. 滑动窗口: 保持 kWindow 个活跃对象, 每次随机替换其中一个, 空闲链表被打乱
+对象池默认关闭 poison(kPoison = false), 另外单独测一次开启 poison 的开销
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "object_pool.h"
+
+struct Order {
+  std::uint64_t id;
+  double price;
+  double quantity;
+  std::uint64_t timestamp;
+  std::uint32_t side;
+  std::uint32_t flags;
+  std::uint64_t owner;
+};  // struct Order
+
+inline constexpr std::size_t kWindow = 4096;
+
+struct NewDelete {
+  Order* construct(std::uint64_t id) { return new Order{id, 1.0, 2.0, id, 0, 0, 0}; }
+  void destroy(Order* p) { delete p; }
+};  // struct NewDelete
+
+template <bool kPoison>
+struct Pooled {
+  pool::ObjectPool<Order, kPoison> pool;
+  Order* construct(std::uint64_t id) { return pool.construct(Order{id, 1.0, 2.0, id, 0, 0, 0}); }
+  void destroy(Order* p) { pool.destroy(p); }
+};  // struct Pooled
+
+template <typename Alloc>
+void immediate(Alloc& alloc, std::size_t cycles) {
+  for (std::size_t i = 0; i < cycles; ++i) {
+    Order* p = alloc.construct(i);
+    utils::do_not_optimize(p->id);
+    alloc.destroy(p);
+  }
+}
+
+template <typename Alloc>
+void window(Alloc& alloc, std::size_t cycles, const std::vector<std::uint32_t>& slots) {
+  std::vector<Order*> live(kWindow);
+  for (std::size_t i = 0; i < kWindow; ++i) {
+    live[i] = alloc.construct(i);
+  }
+  for (std::size_t i = 0; i < cycles; ++i) {
+    Order*& victim = live[slots[i % slots.size()]];
+    alloc.destroy(victim);
+    victim = alloc.construct(i);
+  }
+  for (Order* p : live) {
+    alloc.destroy(p);
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::size_t cycles = utils::arg_or(argc, argv, 1, 10'000'000);
+  std::vector<std::uint32_t> slots(1 << 16);
+  std::mt19937 rng(42);
+  for (auto& s : slots) {
+    s = static_cast<std::uint32_t>(rng() % kWindow);
+  }
+  std::println("cycles: {}, sizeof(Order) = {}", cycles, sizeof(Order));
+
+  NewDelete global;
+  Pooled<false> pooled;
+  Pooled<true> poisoned;
+  utils::run_benchmark("immediate free, new / delete", cycles, [&] { immediate(global, cycles); });
+  utils::run_benchmark("immediate free, ObjectPool", cycles, [&] { immediate(pooled, cycles); });
+  utils::run_benchmark("immediate free, ObjectPool with poison", cycles, [&] { immediate(poisoned, cycles); });
+  utils::run_benchmark("window of 4096, new / delete", cycles, [&] { window(global, cycles, slots); });
+  utils::run_benchmark("window of 4096, ObjectPool", cycles, [&] { window(pooled, cycles, slots); });
+  utils::run_benchmark("window of 4096, ObjectPool with poison", cycles, [&] { window(poisoned, cycles, slots); });
+  std::println("ObjectPool capacity: {}", pooled.pool.capacity());
+  return 0;
+}
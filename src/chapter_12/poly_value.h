@@ -0,0 +1,277 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 12:21:47
+# Desc   : poly::poly_value<Signature, kCapacity>: 带内部缓冲区的类型擦除值, 手写虚函数表
+########################################################################
+*/
+/*
+12.1.1 的 Dynamic<T> 说明成员函数模板不能是虚函数, template <typename T2> virtual void copy(const T2&) 无法声明
+常见的绕过方法是类型擦除: 构造时(此时知道具体类型 T)为 T 生成一张函数表, 之后只通过函数表操作对象
+std::any / std::function 就是这样做的, 但它们的内部缓冲区很小(libstdc++ 只有 16 字节), 稍大一点的对象就要分配堆内存
+poly_value 把内部缓冲区的大小作为模板参数(默认 48 字节), 函数表是手写的:
+1. 函数表 VTable 包含 copy / relocate / destroy 和 call(Signature 为 void 时没有 call, 只保存值, 相当于 std::any)
+   每个类型 T 对应一个 constexpr 的静态函数表, poly_value 只保存函数表的指针, target<T>() 通过比较函数表的地址判断类型
+2. sizeof(T) <= kCapacity、对齐不超过 max_align_t、并且移动构造不抛出异常时, 对象保存在内部缓冲区中, 否则分配在堆上
+3. 函数表中的函数指针为 nullptr 表示 "按字节复制 / 什么也不做", 这是平凡类型的快速路径, 不需要间接调用:
+   内部缓冲区中的可平凡复制类型: copy、relocate 都是 memcpy 整个缓冲区, destroy 什么也不做
+   堆上的对象: relocate 只需要复制指针, 也是 memcpy
+4. 空的 poly_value 指向一张空函数表, 所以 operator() 不需要判断是否为空, 空函数表的 call 抛出 std::bad_function_call
+5. 和 std::function 一样, 只能保存可复制构造的类型, operator() 是 const 的, 但调用的是对象的非 const operator()
+*/
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace poly {
+
+inline constexpr std::size_t kDefaultCapacity = 48;
+
+template <typename Signature = void, std::size_t kCapacity = kDefaultCapacity>
+class poly_value;
+
+namespace detail {
+
+template <std::size_t kCapacity>
+union Storage {
+  void* heap;
+  alignas(std::max_align_t) unsigned char buffer[kCapacity];
+};  // union Storage
+
+template <typename T, std::size_t kCapacity>
+inline constexpr bool kFitsInline =
+    sizeof(T) <= kCapacity && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<T>;
+
+template <typename T, std::size_t kCapacity>
+T* object(Storage<kCapacity>& s) noexcept {
+  if constexpr (kFitsInline<T, kCapacity>) {
+    return std::launder(reinterpret_cast<T*>(s.buffer));
+  } else {
+    return static_cast<T*>(s.heap);
+  }
+}
+
+// Signature 为 void 时函数表中没有 call
+template <typename Storage, typename Signature>
+struct CallSlot {};
+template <std::size_t kCapacity, typename R, typename... Args>
+struct CallSlot<Storage<kCapacity>, R(Args...)> {
+  R (*call)(Storage<kCapacity>&, Args&&...) = nullptr;
+
+  template <typename T>
+  static R invoke(Storage<kCapacity>& s, Args&&... args) {
+    return std::invoke_r<R>(*object<T>(s), std::forward<Args>(args)...);
+  }
+  static R invoke_empty(Storage<kCapacity>&, Args&&...) { throw std::bad_function_call(); }
+};  // struct CallSlot
+
+template <typename Storage, typename Signature>
+struct VTable : CallSlot<Storage, Signature> {
+  void (*copy)(const Storage& from, Storage& to) = nullptr;       // nullptr: memcpy
+  void (*relocate)(Storage& from, Storage& to) noexcept = nullptr;  // nullptr: memcpy, 之后 from 不再析构
+  void (*destroy)(Storage&) noexcept = nullptr;                    // nullptr: 什么也不做
+  bool local = true;
+};  // struct VTable
+
+template <typename T, typename Signature>
+inline constexpr bool kCompatible = true;
+template <typename T, typename R, typename... Args>
+inline constexpr bool kCompatible<T, R(Args...)> = std::is_invocable_r_v<R, T&, Args...>;
+
+// 只有 Signature 不是 void 时才有 operator()
+template <typename Derived, typename Signature>
+class CallOperator {};
+template <typename Derived, typename R, typename... Args>
+class CallOperator<Derived, R(Args...)> {
+public:
+  R operator()(Args... args) const {
+    const auto& self = static_cast<const Derived&>(*this);
+    return self.vtable_->call(self.storage_, std::forward<Args>(args)...);
+  }
+};  // class CallOperator
+
+}  // namespace detail
+
+template <typename Signature, std::size_t kCapacity>
+class poly_value : public detail::CallOperator<poly_value<Signature, kCapacity>, Signature> {
+  friend class detail::CallOperator<poly_value, Signature>;
+  using Storage = detail::Storage<kCapacity>;
+  using VTable = detail::VTable<Storage, Signature>;
+
+public:
+  static constexpr std::size_t capacity = kCapacity;
+  template <typename T>
+  static constexpr bool fits_inline = detail::kFitsInline<T, kCapacity>;
+
+  poly_value() noexcept = default;
+
+  template <typename F, typename T = std::decay_t<F>>
+    requires(!std::same_as<T, poly_value> && std::copy_constructible<T> && detail::kCompatible<T, Signature>)
+  poly_value(F&& value) {
+    construct<T>(std::forward<F>(value));
+  }
+
+  template <typename T, typename... Args>
+    requires(std::copy_constructible<T> && detail::kCompatible<T, Signature>)
+  explicit poly_value(std::in_place_type_t<T>, Args&&... args) {
+    construct<T>(std::forward<Args>(args)...);
+  }
+
+  poly_value(const poly_value& other) {
+    if (other.vtable_->copy == nullptr) {
+      std::memcpy(&storage_, &other.storage_, sizeof(Storage));
+    } else {
+      other.vtable_->copy(other.storage_, storage_);
+    }
+    vtable_ = other.vtable_;
+  }
+
+  poly_value(poly_value&& other) noexcept { steal(other); }
+
+  poly_value& operator=(const poly_value& other) {
+    if (this != &other) {
+      poly_value copy(other);
+      reset();
+      steal(copy);
+    }
+    return *this;
+  }
+
+  poly_value& operator=(poly_value&& other) noexcept {
+    if (this != &other) {
+      reset();
+      steal(other);
+    }
+    return *this;
+  }
+
+  ~poly_value() { reset(); }
+
+  template <typename T, typename... Args>
+    requires(std::copy_constructible<T> && detail::kCompatible<T, Signature>)
+  T& emplace(Args&&... args) {
+    reset();
+    construct<T>(std::forward<Args>(args)...);
+    return *object<T>(storage_);
+  }
+
+  void reset() noexcept {
+    if (vtable_->destroy != nullptr) {
+      vtable_->destroy(storage_);
+    }
+    vtable_ = &kEmpty;
+  }
+
+  void swap(poly_value& other) noexcept {
+    poly_value tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  bool has_value() const noexcept { return vtable_ != &kEmpty; }
+  explicit operator bool() const noexcept { return has_value(); }
+  // 对象是否保存在内部缓冲区中(没有分配堆内存)
+  bool is_inline() const noexcept { return vtable_->local; }
+
+  // 保存的对象类型是 T 时返回它的地址, 否则返回 nullptr
+  template <typename T>
+  T* target() noexcept {
+    return vtable_ == &kVTable<T> ? object<T>(storage_) : nullptr;
+  }
+  template <typename T>
+  const T* target() const noexcept {
+    return vtable_ == &kVTable<T> ? object<T>(storage_) : nullptr;
+  }
+
+private:
+  template <typename T>
+  static T* object(Storage& s) noexcept {
+    return detail::object<T>(s);
+  }
+  template <typename T>
+  static const T* object(const Storage& s) noexcept {
+    return detail::object<T>(const_cast<Storage&>(s));
+  }
+
+  template <typename T, typename... Args>
+  static void construct_at(Storage& s, Args&&... args) {
+    if constexpr (fits_inline<T>) {
+      ::new (static_cast<void*>(s.buffer)) T(std::forward<Args>(args)...);
+    } else {
+      s.heap = new T(std::forward<Args>(args)...);
+    }
+  }
+
+  // 构造失败时保持为空
+  template <typename T, typename... Args>
+  void construct(Args&&... args) {
+    construct_at<T>(storage_, std::forward<Args>(args)...);
+    vtable_ = &kVTable<T>;
+  }
+
+  void steal(poly_value& other) noexcept {
+    if (other.vtable_->relocate == nullptr) {
+      std::memcpy(&storage_, &other.storage_, sizeof(Storage));
+    } else {
+      other.vtable_->relocate(other.storage_, storage_);
+    }
+    vtable_ = std::exchange(other.vtable_, &kEmpty);
+  }
+
+  template <typename T>
+  static constexpr VTable make_vtable() {
+    VTable vtable;
+    vtable.local = fits_inline<T>;
+    constexpr bool trivial = fits_inline<T> && std::is_trivially_copyable_v<T>;
+    if constexpr (!trivial) {
+      vtable.copy = [](const Storage& from, Storage& to) { construct_at<T>(to, *object<T>(from)); };
+      vtable.destroy = [](Storage& s) noexcept {
+        if constexpr (fits_inline<T>) {
+          std::destroy_at(object<T>(s));
+        } else {
+          delete object<T>(s);
+        }
+      };
+    }
+    if constexpr (fits_inline<T> && !trivial) {
+      vtable.relocate = [](Storage& from, Storage& to) noexcept {
+        T* src = object<T>(from);
+        ::new (static_cast<void*>(to.buffer)) T(std::move(*src));
+        std::destroy_at(src);
+      };
+    }
+    if constexpr (!std::is_void_v<Signature>) {
+      vtable.call = &VTable::template invoke<T>;
+    }
+    return vtable;
+  }
+
+  static constexpr VTable make_empty() {
+    VTable vtable;
+    if constexpr (!std::is_void_v<Signature>) {
+      vtable.call = &VTable::invoke_empty;
+    }
+    return vtable;
+  }
+
+  template <typename T>
+  static constexpr VTable kVTable = make_vtable<T>();
+  static constexpr VTable kEmpty = make_empty();
+
+  mutable Storage storage_;
+  const VTable* vtable_{&kEmpty};
+};  // class poly_value
+
+}  // namespace poly
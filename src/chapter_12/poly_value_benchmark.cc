@@ -0,0 +1,88 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 12:54:08
+# Desc   : poly::poly_value 与 std::any、std::function 的构造、复制和调用对比
+########################################################################
+*/
+/*
+用法: chapter_12_poly_value_benchmark [ops]
+保存的对象都是 int(int) 的 lambda, 按捕获的大小分为:
+  8 字节: 三者都保存在内部缓冲区
+  40 字节: std::any / std::function 分配堆内存, poly_value<48> 保存在内部缓冲区
+  96 字节: 三者都分配堆内存
+  std::string(32 字节, 不可平凡复制): std::function 分配堆内存, poly_value 走函数表中的 copy / destroy
+1. construct: 构造 + 析构
+2. copy: 复制构造 + 析构
+3. call: 通过类型擦除调用(std::any 需要 any_cast 到具体类型, 不参与对比)
+*/
+
+#include <any>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <print>
+#include <string>
+
+#include "utils/benchmark.h"
+
+#include "poly_value.h"
+
+using Poly = poly::poly_value<int(int)>;
+
+template <typename Holder, typename F>
+void bench(const char* holder, const char* payload, std::size_t ops, const F& f) {
+  std::string prefix = std::string(payload) + ", " + holder;
+  utils::run_benchmark(prefix + ", construct", ops, [&] {
+    for (std::size_t i = 0; i < ops; ++i) {
+      Holder h(f);
+      utils::do_not_optimize(h);
+    }
+  });
+  const Holder origin(f);
+  utils::run_benchmark(prefix + ", copy", ops, [&] {
+    for (std::size_t i = 0; i < ops; ++i) {
+      Holder h(origin);
+      utils::do_not_optimize(h);
+    }
+  });
+  if constexpr (!std::is_same_v<Holder, std::any>) {
+    utils::run_benchmark(prefix + ", call", ops, [&] {
+      int s = 0;
+      for (std::size_t i = 0; i < ops; ++i) {
+        s += origin(static_cast<int>(i));
+      }
+      utils::do_not_optimize(s);
+    });
+  }
+}
+
+template <typename F>
+void bench_payload(const char* payload, std::size_t ops, const F& f) {
+  std::println("{}: sizeof = {}, poly_value inline = {}", payload, sizeof(F), Poly::fits_inline<F>);
+  bench<std::any>("std::any", payload, ops, f);
+  bench<std::function<int(int)>>("std::function", payload, ops, f);
+  bench<Poly>("poly_value", payload, ops, f);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t ops = utils::arg_or(argc, argv, 1, 2'000'000);
+  std::println("sizeof(std::any) = {}, sizeof(std::function) = {}, sizeof(poly_value) = {}", sizeof(std::any),
+      sizeof(std::function<int(int)>), sizeof(Poly));
+
+  const long long k = 3;
+  bench_payload("8 bytes", ops, [k](int x) { return x + static_cast<int>(k); });
+  const std::array<int, 10> medium{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  bench_payload("40 bytes", ops, [medium](int x) { return x + medium[x & 7]; });
+  const std::array<int, 24> large{1, 2, 3, 4, 5, 6, 7, 8};
+  bench_payload("96 bytes", ops, [large](int x) { return x + large[x & 7]; });
+  // 捕获 const std::string 时 lambda 的移动构造会退化为复制, 可能抛出异常, 所以这里不加 const
+  std::string name = "a name that does not fit in the small string buffer";
+  bench_payload("std::string", ops, [name](int x) { return x + static_cast<int>(name.size()); });
+  return 0;
+}
@@ -0,0 +1,274 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 15:58:03
+# Desc   : reloc::is_trivially_relocatable<T> 以及按 memmove 实现的 relocate 算法和 Vector<T>
+########################################################################
+*/
+/*
+"重定位"(relocate) = 移动构造到新地址 + 析构旧对象, vector 扩容和删除中间元素时都是在重定位元素
+对很多类型来说, 重定位等价于按字节复制, 之后不再访问旧对象即可, 例如 std::unique_ptr: 移动构造再析构旧对象,
+结果和 memcpy 指针完全相同, 但编译器并不知道, 只能逐个调用移动构造函数和析构函数
+1. 特征的形式和 12.1 的 data_copyable<T> = Data<T>::copyable 相同:
+   类模板 Relocatable<T> 的静态成员 trivially 是定制点(默认是 std::is_trivially_copyable_v<T>), 类型通过特化它声明自己
+   变量模板 is_trivially_relocatable<T> = Relocatable<T>::trivially 是使用的接口
+   这里为 std::unique_ptr(默认删除器)和 std::shared_ptr 声明了可以平凡重定位
+   InternedString 只有一个 uint32_t, 本身就是可平凡复制的
+   libstdc++ 的 std::string 指向自己内部的缓冲区(SSO), 不能按字节移动, 所以不能声明
+2. relocate_at(src, dst) / uninitialized_relocate_n(first, n, d_first):
+   可平凡重定位的类型是 memcpy / memmove, 其他类型逐个移动构造(std::move_if_noexcept: 移动构造可能抛出异常时复制)再析构
+   uninitialized_relocate_n 允许 d_first <= first 的重叠区间(向前移动, 用于删除中间的元素)
+3. Vector<T>: 扩容时用 uninitialized_relocate_n 搬运元素; erase 时可平凡重定位的类型析构被删除的元素后 memmove 后面的元素,
+   其他类型和 std::vector 一样逐个移动赋值
+*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace reloc {
+
+// 定制点: 类型可以特化 Relocatable 声明自己可以按字节重定位
+template <typename T>
+struct Relocatable {
+  static constexpr bool trivially = std::is_trivially_copyable_v<T>;
+};  // struct Relocatable
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable = Relocatable<std::remove_cv_t<T>>::trivially;
+
+template <typename T>
+struct Relocatable<std::unique_ptr<T>> {
+  static constexpr bool trivially = true;
+};  // struct Relocatable<std::unique_ptr<T>>
+template <typename T>
+struct Relocatable<std::shared_ptr<T>> {
+  static constexpr bool trivially = true;
+};  // struct Relocatable<std::shared_ptr<T>>
+
+// 把 *src 重定位到未初始化的 dst, 之后 src 是未初始化的内存
+template <typename T>
+T* relocate_at(T* src, T* dst) noexcept(is_trivially_relocatable<T> || std::is_nothrow_move_constructible_v<T>) {
+  if constexpr (is_trivially_relocatable<T>) {
+    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T));
+    return std::launder(dst);
+  } else {
+    T* p = std::construct_at(dst, std::move_if_noexcept(*src));
+    std::destroy_at(src);
+    return p;
+  }
+}
+
+// 把 [first, first + n) 重定位到未初始化的 [d_first, d_first + n), 返回 d_first + n
+// 构造抛出异常时已经构造的目标元素被析构; 可以复制的类型源元素保持不变,
+// 移动构造可能抛出异常又不能复制的类型和 std::vector 一样仍然移动, 这时源元素的状态是未指定的
+template <typename T>
+T* uninitialized_relocate_n(T* first, std::size_t n, T* d_first) {
+  if constexpr (is_trivially_relocatable<T>) {
+    if (n != 0) {
+      std::memmove(static_cast<void*>(d_first), static_cast<const void*>(first), n * sizeof(T));
+    }
+    return d_first + n;
+  } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+    assert(d_first <= first || d_first >= first + n);
+    for (std::size_t i = 0; i < n; ++i) {
+      std::construct_at(d_first + i, std::move(first[i]));
+      std::destroy_at(first + i);
+    }
+    return d_first + n;
+  } else {
+    assert(d_first + n <= first || d_first >= first + n);
+    std::size_t built = 0;
+    try {
+      for (; built < n; ++built) {
+        std::construct_at(d_first + built, std::move_if_noexcept(first[built]));
+      }
+    } catch (...) {
+      std::destroy_n(d_first, built);
+      throw;
+    }
+    std::destroy_n(first, n);
+    return d_first + n;
+  }
+}
+
+template <typename T>
+class Vector {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  Vector() = default;
+  // 委托构造完成之后抛出异常会调用析构函数, 已经构造的元素和内存都会被释放
+  Vector(std::initializer_list<T> init) : Vector() {
+    reserve(init.size());
+    for (const auto& v : init) {
+      emplace_back(v);
+    }
+  }
+  Vector(const Vector& other) : Vector() {
+    reserve(other.size_);
+    size_ = std::uninitialized_copy_n(other.data_, other.size_, data_) - data_;
+  }
+  Vector(Vector&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+  Vector& operator=(Vector other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~Vector() {
+    clear();
+    deallocate(data_, capacity_);
+  }
+
+  void swap(Vector& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  size_type size() const { return size_; }
+  size_type capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+  T& operator[](size_type i) {
+    assert(i < size_);
+    return data_[i];
+  }
+  const T& operator[](size_type i) const {
+    assert(i < size_);
+    return data_[i];
+  }
+  T& back() {
+    assert(!empty());
+    return data_[size_ - 1];
+  }
+  const T& back() const {
+    assert(!empty());
+    return data_[size_ - 1];
+  }
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  void reserve(size_type n) {
+    if (n > capacity_) {
+      reallocate(n);
+    }
+  }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ < capacity_) [[likely]] {
+      T* p = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+      ++size_;
+      return *p;
+    }
+    return emplace_back_grow(std::forward<Args>(args)...);
+  }
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  void pop_back() {
+    assert(!empty());
+    std::destroy_at(data_ + --size_);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    T* begin = data_ + (first - data_);
+    T* end = data_ + (last - data_);
+    if (begin == end) {
+      return begin;
+    }
+    const auto removed = static_cast<size_type>(end - begin);
+    if constexpr (is_trivially_relocatable<T>) {
+      std::destroy(begin, end);
+      uninitialized_relocate_n(end, static_cast<size_type>(data_ + size_ - end), begin);
+    } else {
+      std::destroy(std::move(end, data_ + size_, begin), data_ + size_);
+    }
+    size_ -= removed;
+    return begin;
+  }
+
+  void clear() {
+    std::destroy_n(data_, size_);
+    size_ = 0;
+  }
+
+private:
+  static T* allocate(size_type n) { return std::allocator<T>().allocate(n); }
+  static void deallocate(T* p, size_type n) {
+    if (p != nullptr) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  size_type next_capacity() const { return std::max<size_type>(capacity_ * 2, 4); }
+
+  void reallocate(size_type n) {
+    T* data = allocate(n);
+    try {
+      uninitialized_relocate_n(data_, size_, data);
+    } catch (...) {
+      deallocate(data, n);
+      throw;
+    }
+    deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = n;
+  }
+
+  // 先在新的内存中构造新元素(args 可能引用旧的元素), 再搬运旧的元素
+  template <typename... Args>
+  T& emplace_back_grow(Args&&... args) {
+    const size_type n = next_capacity();
+    T* data = allocate(n);
+    T* p = nullptr;
+    try {
+      p = std::construct_at(data + size_, std::forward<Args>(args)...);
+      uninitialized_relocate_n(data_, size_, data);
+    } catch (...) {
+      if (p != nullptr) {
+        std::destroy_at(p);
+      }
+      deallocate(data, n);
+      throw;
+    }
+    deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = n;
+    ++size_;
+    return *p;
+  }
+
+  T* data_{nullptr};
+  size_type size_{0};
+  size_type capacity_{0};
+};  // class Vector
+
+// Vector 只保存指针和大小, 没有指向自己的指针
+template <typename T>
+struct Relocatable<Vector<T>> {
+  static constexpr bool trivially = true;
+};  // struct Relocatable<Vector<T>>
+
+}  // namespace reloc
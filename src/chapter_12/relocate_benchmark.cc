@@ -0,0 +1,98 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 16:37:45
+# Desc   : reloc::Vector 与 std::vector 的扩容和删除中间元素对比
+########################################################################
+*/
+/*
+用法: chapter_12_relocate_benchmark [elements] [erases]
+元素类型:
+  std::unique_ptr<int>: 声明了可平凡重定位
+  Widget(unique_ptr + 3 个 double): 通过特化 reloc::Relocatable 声明可平凡重定位
+  std::string(短字符串): 不能平凡重定位, reloc::Vector 和 std::vector 一样逐个移动
+1. grow: 不预留容量, 逐个 push_back(从预先构造好的元素移动过来), 扩容时要搬运已有的元素
+   计时中包含把元素移回 source 的循环, 两种容器的这部分开销相同
+2. erase middle: elements 个元素, 反复删除正中间的元素 erases 次, 每次都要把后一半的元素向前移动一位
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <print>
+#include <string>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "relocate.h"
+
+struct Widget {
+  std::unique_ptr<int> id;
+  double x;
+  double y;
+  double weight;
+};  // struct Widget
+template <>
+struct reloc::Relocatable<Widget> {
+  static constexpr bool trivially = true;
+};  // struct reloc::Relocatable<Widget>
+
+template <typename Vec, typename T>
+void bench_grow(const char* name, std::vector<T>& source) {
+  utils::run_benchmark(name, source.size(), [&] {
+    Vec v;
+    for (auto& item : source) {
+      v.push_back(std::move(item));
+    }
+    utils::do_not_optimize(v.data());
+    // 放回去, 下一轮重复时搬运的还是同样的元素
+    for (std::size_t i = 0; i < source.size(); ++i) {
+      source[i] = std::move(v[i]);
+    }
+  });
+}
+
+template <typename Vec, typename Make>
+void bench_erase(const char* name, std::size_t elements, std::size_t erases, Make make) {
+  Vec v;
+  for (std::size_t i = 0; i < elements; ++i) {
+    v.push_back(make(i));
+  }
+  utils::run_benchmark(name, erases, [&] {
+    for (std::size_t k = 0; k < erases; ++k) {
+      v.erase(v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2));
+    }
+    utils::do_not_optimize(v.data());
+  }, 1);
+}
+
+template <typename T, typename Make>
+void bench_type(const char* type, std::size_t elements, std::size_t erases, Make make) {
+  std::println("{}: sizeof = {}, trivially relocatable = {}", type, sizeof(T), reloc::is_trivially_relocatable<T>);
+  std::vector<T> source;
+  for (std::size_t i = 0; i < elements; ++i) {
+    source.push_back(make(i));
+  }
+  bench_grow<std::vector<T>>("  grow, std::vector", source);
+  bench_grow<reloc::Vector<T>>("  grow, reloc::Vector", source);
+  bench_erase<std::vector<T>>("  erase middle, std::vector", elements, erases, make);
+  bench_erase<reloc::Vector<T>>("  erase middle, reloc::Vector", elements, erases, make);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t elements = utils::arg_or(argc, argv, 1, 200'000);
+  const std::size_t erases = std::min(elements, utils::arg_or(argc, argv, 2, 1'000));
+  std::println("elements: {}, erases: {}", elements, erases);
+  bench_type<std::unique_ptr<int>>("std::unique_ptr<int>", elements, erases,
+      [](std::size_t i) { return std::make_unique<int>(static_cast<int>(i)); });
+  bench_type<Widget>("Widget", elements, erases,
+      [](std::size_t i) { return Widget{std::make_unique<int>(static_cast<int>(i)), 1.0, 2.0, 3.0}; });
+  bench_type<std::string>("std::string", elements, erases, [](std::size_t i) { return "item " + std::to_string(i); });
+  return 0;
+}
@@ -0,0 +1,128 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 15:04:26
+# Desc   : sharded::sharded_counter<T>: 按 CPU 分片的累加器, 用于多线程更新的静态成员
+########################################################################
+*/
+/*
+12.1 的 CupBoard<I>::total_weight 是类模板的静态成员, 所有线程共享同一个对象
+多个线程同时更新一个 std::atomic<double> 时, 它所在的缓存行在各个核之间来回传递, 线程越多越慢
+sharded_counter<T, kShards> 把计数分散到 kShards 个槽位中:
+1. 每个槽位独占一个缓存行(alignas(kCacheLine)), 不同槽位之间没有伪共享
+2. add 用当前 CPU 的编号选择槽位(Linux 上是 sched_getcpu, glibc 通过 rseq 读取, 只需要几纳秒)
+   取不到 CPU 编号时按线程分配槽位(第一次使用时轮流分配)
+   同一个 CPU 上的线程共享槽位, 线程在 add 的过程中被迁移也不影响正确性, 只是偶尔会有竞争, 所以槽位仍然是原子的
+3. 递增只需要 relaxed 的 fetch_add(浮点数是 C++20 的 atomic<double>::fetch_add)
+4. load() 把所有槽位相加, 是 O(kShards) 的, 适合写多读少的统计量; 和并发的 add 之间没有一致的快照
+5. 构造函数是 constexpr 的, 可以作为类模板的 inline static 成员, 在常量初始化阶段完成, 没有静态初始化顺序的问题
+   每个计数器占用 kShards * kCacheLine 字节(默认 4 KiB)
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace sharded {
+
+inline constexpr std::size_t kCacheLine = 64;
+inline constexpr std::size_t kDefaultShards = 64;
+
+namespace detail {
+
+// 没有 CPU 编号时, 每个线程第一次使用时分配的编号
+inline std::uint32_t thread_slot() {
+  static std::atomic<std::uint32_t> next{0};
+  thread_local const std::uint32_t slot = next.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+inline std::uint32_t current_slot() {
+#if defined(__linux__)
+  const int cpu = ::sched_getcpu();
+  if (cpu >= 0) [[likely]] {
+    return static_cast<std::uint32_t>(cpu);
+  }
+#endif
+  return thread_slot();
+}
+
+}  // namespace detail
+
+template <typename T, std::size_t kShards = kDefaultShards>
+  requires(std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+class sharded_counter {
+  static_assert(kShards > 0 && (kShards & (kShards - 1)) == 0, "kShards must be a power of two");
+
+public:
+  using value_type = T;
+
+  constexpr sharded_counter() noexcept = default;
+  sharded_counter(const sharded_counter&) = delete;
+  sharded_counter& operator=(const sharded_counter&) = delete;
+
+  void add(T delta) noexcept {
+    slots_[detail::current_slot() & (kShards - 1)].value.fetch_add(delta, std::memory_order_relaxed);
+  }
+  void sub(T delta) noexcept { add(static_cast<T>(-delta)); }
+  sharded_counter& operator+=(T delta) noexcept {
+    add(delta);
+    return *this;
+  }
+  sharded_counter& operator-=(T delta) noexcept {
+    sub(delta);
+    return *this;
+  }
+  // 和 std::atomic 不同, 自增不返回结果(那需要读取所有槽位)
+  void operator++() noexcept
+    requires std::integral<T>
+  {
+    add(1);
+  }
+  void operator--() noexcept
+    requires std::integral<T>
+  {
+    add(static_cast<T>(-1));
+  }
+
+  // 所有槽位之和
+  T load() const noexcept {
+    T sum{};
+    for (const auto& slot : slots_) {
+      sum += slot.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+  operator T() const noexcept { return load(); }
+
+  // 与并发的 add 同时调用时, 部分增量可能被清掉
+  void reset() noexcept {
+    for (auto& slot : slots_) {
+      slot.value.store(T{}, std::memory_order_relaxed);
+    }
+  }
+
+  static constexpr std::size_t shards() { return kShards; }
+
+private:
+  struct alignas(kCacheLine) Slot {
+    std::atomic<T> value{};
+  };  // struct Slot
+
+  std::array<Slot, kShards> slots_{};
+};  // class sharded_counter
+
+}  // namespace sharded
@@ -0,0 +1,76 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 15:32:17
+# Desc   : sharded::sharded_counter 与 std::atomic 的多线程累加对比
+########################################################################
+*/
+/*
+用法: chapter_12_sharded_counter_benchmark [ops] [max_threads]
+线程数 1 / 2 / 4 ... max_threads(默认 64), 总累加次数固定为 ops, 平均分给各个线程
+结果是每次累加的平均墙钟时间, 线程数超过 CPU 核数之后, 同一个核上的线程共享槽位, 不会再变快
+1. std::atomic<double>::fetch_add(C++20, 实现是 CAS 循环)
+2. std::atomic<std::uint64_t>::fetch_add
+3. sharded_counter<double> / sharded_counter<std::uint64_t>
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <thread>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "sharded_counter.h"
+
+template <typename Work>
+void run_threads(std::size_t threads, Work work) {
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back(work);
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+template <typename Counter, typename T>
+void bench(const char* name, std::size_t threads, std::size_t per_thread, T delta) {
+  Counter counter;
+  utils::run_benchmark(name, per_thread * threads, [&] {
+    run_threads(threads, [&] {
+      for (std::size_t i = 0; i < per_thread; ++i) {
+        counter.fetch_add(delta, std::memory_order_relaxed);
+      }
+    });
+  });
+}
+
+template <typename T>
+struct Sharded {
+  sharded::sharded_counter<T> counter;
+  void fetch_add(T delta, std::memory_order) { counter.add(delta); }
+};  // struct Sharded
+
+int main(int argc, char** argv) {
+  const std::size_t ops = utils::arg_or(argc, argv, 1, 4'000'000);
+  const std::size_t max_threads = utils::arg_or(argc, argv, 2, 64);
+  std::println("hardware threads: {}, sizeof(sharded_counter<double>) = {}", std::thread::hardware_concurrency(),
+      sizeof(sharded::sharded_counter<double>));
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    const std::size_t per_thread = ops / threads;
+    std::println("{} thread(s)", threads);
+    bench<std::atomic<double>>("  std::atomic<double>", threads, per_thread, 0.5);
+    bench<std::atomic<std::uint64_t>>("  std::atomic<uint64_t>", threads, per_thread, std::uint64_t{1});
+    bench<Sharded<double>>("  sharded_counter<double>", threads, per_thread, 0.5);
+    bench<Sharded<std::uint64_t>>("  sharded_counter<uint64_t>", threads, per_thread, std::uint64_t{1});
+  }
+  return 0;
+}
@@ -0,0 +1,221 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 11:25:10
+# Desc   : slot::List<T>: 以 slot map 实现的 List, Handle<U> 是 下标 + 代数(generation)
+########################################################################
+*/
+/*
+12.1 的 List<T> 只声明了成员类模板 Handle<U>(在类外定义)和构造函数模板 List(const List<U>&), 这里给它们加上内容
+1. 元素按插入顺序紧密地存放在 values_ 中, 遍历和 std::vector 一样快
+2. Handle 不直接指向元素, 而是指向一个 slot, slot 记录元素当前在 values_ 中的位置和它的代数 generation
+   handle 的 generation 和 slot 的不一致时, 说明元素已经被删除(slot 可能已经被复用), get() 返回 nullptr, O(1)
+3. erase 把 values_ 的最后一个元素移动到被删除的位置再 pop_back(swap-and-pop), 然后修正被移动元素的 slot
+   所以删除会改变遍历顺序, 但所有仍然有效的 handle 都不受影响
+4. 空闲的 slot 组成链表, 插入时优先复用; slot 的数量只增不减, 每个 slot 8 字节
+5. Handle<U> 中的 U 是元素类型, Handle<T> 可以修改元素, Handle<const T> 只读, Handle<T> 可以转换为 Handle<const T>
+6. List(const List<U>&) 逐个转换元素, 并保留所有的 slot, 原来的 handle 通过 rebind<U>(h) 转换后在新的 List 中也有效
+7. generation 是 32 位的, 同一个 slot 被删除 2^32 次之后旧的 handle 可能被误认为有效
+*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace slot {
+
+template <typename T>
+class List {
+  template <typename>
+  friend class List;
+
+public:
+  template <typename U>
+  class Handle;
+  using handle = Handle<T>;
+  using const_handle = Handle<const T>;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  List() = default;
+  template <typename U>
+  List(const List<U>& other);
+
+  template <typename... Args>
+  handle emplace(Args&&... args);
+  handle insert(const T& value) { return emplace(value); }
+  handle insert(T&& value) { return emplace(std::move(value)); }
+
+  // handle 已经失效时返回 false
+  bool erase(const_handle h);
+
+  template <typename U>
+  U* get(Handle<U> h) const;
+  bool contains(const_handle h) const { return get(h) != nullptr; }
+  // 把从 List<V> 复制来的 List 中的 handle 转换为这个 List 的 handle, slot 和 generation 不变
+  template <typename V>
+  static handle rebind(typename List<V>::handle h) { return handle(h.index(), h.generation()); }
+  template <typename V>
+  static const_handle rebind(typename List<V>::const_handle h) { return const_handle(h.index(), h.generation()); }
+  template <typename U>
+  U& operator[](Handle<U> h) const {
+    U* p = get(h);
+    assert(p != nullptr && "slot::List: stale handle");
+    return *p;
+  }
+
+  std::size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+  void reserve(std::size_t n) {
+    values_.reserve(n);
+    dense_to_slot_.reserve(n);
+    slots_.reserve(n);
+  }
+  void clear();
+
+  // 按存储顺序遍历所有元素
+  iterator begin() { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+  T* data() { return values_.data(); }
+  const T* data() const { return values_.data(); }
+
+private:
+  static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+  struct Slot {
+    std::uint32_t index;       // 使用中: 元素在 values_ 中的下标; 空闲: 下一个空闲的 slot
+    std::uint32_t generation;  // 每次删除加 1
+  };  // struct Slot
+
+  // values_ 是 mutable 的, 这样 const 的 List 也可以通过 Handle<T> 修改元素(和指针的语义一样)
+  mutable std::vector<T> values_;
+  std::vector<std::uint32_t> dense_to_slot_;  // values_[i] 对应的 slot
+  std::vector<Slot> slots_;
+  std::uint32_t free_head_{kNone};
+};  // class List
+
+// 类外部成员类模板的定义
+template <typename T>
+template <typename U>
+class List<T>::Handle {
+  static_assert(std::is_same_v<std::remove_const_t<U>, T>, "slot::List<T>::Handle<U>: U must be T or const T");
+
+public:
+  Handle() = default;
+  // Handle<T> 可以转换为 Handle<const T>
+  template <typename V>
+    requires(std::is_const_v<U> && !std::is_const_v<V>)
+  Handle(const Handle<V>& other) : index_(other.index_), generation_(other.generation_) {}
+
+  explicit operator bool() const { return index_ != kNone; }
+  std::uint32_t index() const { return index_; }
+  std::uint32_t generation() const { return generation_; }
+  friend bool operator==(const Handle&, const Handle&) = default;
+
+private:
+  friend class List<T>;
+  template <typename>
+  friend class Handle;
+  Handle(std::uint32_t index, std::uint32_t generation) : index_(index), generation_(generation) {}
+
+  std::uint32_t index_{kNone};
+  std::uint32_t generation_{0};
+};  // class List<T>::Handle
+
+template <typename T>
+template <typename U>
+List<T>::List(const List<U>& other)
+    : dense_to_slot_(other.dense_to_slot_), free_head_(other.free_head_) {
+  values_.reserve(other.values_.size());
+  for (const auto& v : other.values_) {
+    values_.emplace_back(v);
+  }
+  slots_.reserve(other.slots_.size());
+  for (const auto& s : other.slots_) {
+    slots_.push_back({s.index, s.generation});
+  }
+}
+
+template <typename T>
+template <typename... Args>
+typename List<T>::handle List<T>::emplace(Args&&... args) {
+  assert(values_.size() < kNone);
+  values_.emplace_back(std::forward<Args>(args)...);
+  const auto dense = static_cast<std::uint32_t>(values_.size() - 1);
+  // 先完成可能抛出异常的 push_back, 再修改 slot
+  try {
+    dense_to_slot_.push_back(kNone);
+    if (free_head_ == kNone) {
+      slots_.push_back({kNone, 0});
+      free_head_ = static_cast<std::uint32_t>(slots_.size() - 1);
+    }
+  } catch (...) {
+    if (dense_to_slot_.size() > values_.size() - 1) {
+      dense_to_slot_.pop_back();
+    }
+    values_.pop_back();
+    throw;
+  }
+  const std::uint32_t index = free_head_;
+  free_head_ = slots_[index].index;
+  slots_[index].index = dense;
+  dense_to_slot_[dense] = index;
+  return handle(index, slots_[index].generation);
+}
+
+template <typename T>
+bool List<T>::erase(const_handle h) {
+  if (!contains(h)) {
+    return false;
+  }
+  Slot& s = slots_[h.index_];
+  const std::uint32_t dense = s.index;
+  const std::uint32_t last = static_cast<std::uint32_t>(values_.size() - 1);
+  if (dense != last) {
+    values_[dense] = std::move(values_[last]);
+    dense_to_slot_[dense] = dense_to_slot_[last];
+    slots_[dense_to_slot_[dense]].index = dense;
+  }
+  values_.pop_back();
+  dense_to_slot_.pop_back();
+  ++s.generation;
+  s.index = free_head_;
+  free_head_ = h.index_;
+  return true;
+}
+
+template <typename T>
+template <typename U>
+U* List<T>::get(Handle<U> h) const {
+  if (h.index_ >= slots_.size() || slots_[h.index_].generation != h.generation_) {
+    return nullptr;
+  }
+  return &values_[slots_[h.index_].index];
+}
+
+template <typename T>
+void List<T>::clear() {
+  // 所有 slot 的 generation 加 1, 让现有的 handle 全部失效
+  for (std::uint32_t dense = 0; dense < dense_to_slot_.size(); ++dense) {
+    Slot& s = slots_[dense_to_slot_[dense]];
+    ++s.generation;
+    s.index = free_head_;
+    free_head_ = dense_to_slot_[dense];
+  }
+  values_.clear();
+  dense_to_slot_.clear();
+}
+
+}  // namespace slot
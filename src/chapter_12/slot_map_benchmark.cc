@@ -0,0 +1,129 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 11:58:33
+# Desc   : slot::List 与 std::list、std::unordered_map<id, T> 的对比
+########################################################################
+*/
+/*
+用法: chapter_12_slot_map_benchmark [elements]
+元素是 32 字节的结构体, 三种容器都能通过一个稳定的 "句柄" 访问元素:
+  slot::List: Handle; std::list: 迭代器; std::unordered_map: id
+1. iterate: 遍历全部元素求和
+2. lookup: 按随机顺序通过句柄访问元素
+3. random erase: 按随机顺序删除一半元素
+4. iterate after erase: 删除一半之后再遍历, std::list 的节点在内存中更加分散
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <print>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "slot_map.h"
+
+struct Item {
+  std::uint64_t id;
+  double value;
+  double weight;
+  std::uint64_t flags;
+};  // struct Item
+
+template <typename Container>
+double sum_values(const Container& c) {
+  double s = 0;
+  for (const auto& item : c) {
+    s += item.value;
+  }
+  return s;
+}
+double sum_values(const std::unordered_map<std::uint64_t, Item>& c) {
+  double s = 0;
+  for (const auto& [id, item] : c) {
+    s += item.value;
+  }
+  return s;
+}
+
+int main(int argc, char** argv) {
+  const std::size_t n = utils::arg_or(argc, argv, 1, 1'000'000);
+  std::vector<std::uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  const std::size_t half = n / 2;
+
+  slot::List<Item> slots;
+  std::vector<slot::List<Item>::handle> handles(n);
+  std::list<Item> list;
+  std::vector<std::list<Item>::iterator> iterators(n);
+  std::unordered_map<std::uint64_t, Item> map;
+  slots.reserve(n);
+  map.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const Item item{i, static_cast<double>(i % 100), 1.0, 0};
+    handles[i] = slots.insert(item);
+    iterators[i] = list.insert(list.end(), item);
+    map.emplace(i, item);
+  }
+  std::println("elements: {}", n);
+
+  utils::run_benchmark("iterate, slot::List", n, [&] { utils::do_not_optimize(sum_values(slots)); });
+  utils::run_benchmark("iterate, std::list", n, [&] { utils::do_not_optimize(sum_values(list)); });
+  utils::run_benchmark("iterate, std::unordered_map", n, [&] { utils::do_not_optimize(sum_values(map)); });
+
+  utils::run_benchmark("random lookup, slot::List", n, [&] {
+    double s = 0;
+    for (auto i : order) {
+      s += slots[handles[i]].value;
+    }
+    utils::do_not_optimize(s);
+  });
+  utils::run_benchmark("random lookup, std::list", n, [&] {
+    double s = 0;
+    for (auto i : order) {
+      s += iterators[i]->value;
+    }
+    utils::do_not_optimize(s);
+  });
+  utils::run_benchmark("random lookup, std::unordered_map", n, [&] {
+    double s = 0;
+    for (auto i : order) {
+      s += map.find(i)->second.value;
+    }
+    utils::do_not_optimize(s);
+  });
+
+  utils::run_benchmark("random erase half, slot::List", half, [&] {
+    for (std::size_t k = 0; k < half; ++k) {
+      slots.erase(handles[order[k]]);
+    }
+  }, 1);
+  utils::run_benchmark("random erase half, std::list", half, [&] {
+    for (std::size_t k = 0; k < half; ++k) {
+      list.erase(iterators[order[k]]);
+    }
+  }, 1);
+  utils::run_benchmark("random erase half, std::unordered_map", half, [&] {
+    for (std::size_t k = 0; k < half; ++k) {
+      map.erase(order[k]);
+    }
+  }, 1);
+
+  const std::size_t rest = n - half;
+  utils::run_benchmark("iterate after erase, slot::List", rest, [&] { utils::do_not_optimize(sum_values(slots)); });
+  utils::run_benchmark("iterate after erase, std::list", rest, [&] { utils::do_not_optimize(sum_values(list)); });
+  utils::run_benchmark("iterate after erase, std::unordered_map", rest, [&] { utils::do_not_optimize(sum_values(map)); });
+  return 0;
+}
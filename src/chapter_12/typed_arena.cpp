@@ -0,0 +1,292 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 09:40:18
+# Desc   :
+########################################################################
+*/
+
+#include "typed_arena.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <unordered_map>
+
+namespace arena {
+
+namespace detail {
+
+std::size_t next_type_id() {
+  static std::atomic<std::size_t> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+
+// 空闲的 slot 中保存下一个空闲 slot 的地址
+void*& next_of(void* slot) {
+  return *static_cast<void**>(slot);
+}
+
+struct Batch {
+  void* head;
+  std::size_t count;
+};  // struct Batch
+
+// 存活的 Arena, 线程缓存淘汰或者线程退出时通过它判断 slot 应该还给谁
+struct Registry {
+  std::mutex mutex;
+  std::unordered_map<std::uint64_t, Arena*> arenas;
+  std::uint64_t next_uid{1};
+};  // struct Registry
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+}  // namespace
+
+class SlabPool {
+public:
+  SlabPool(Arena& arena, std::size_t slot_size)
+      : arena_(arena), slot_size_(slot_size), batch_(std::max<std::size_t>(4, kBatchBytes / slot_size)) {}
+
+  std::size_t batch() const { return batch_; }
+
+  // 取一批 slot
+  Batch take() {
+    std::lock_guard lock(mutex_);
+    if (!batches_.empty()) {
+      const Batch b = batches_.back();
+      batches_.pop_back();
+      return b;
+    }
+    if (static_cast<std::size_t>(carve_end_ - carve_) < slot_size_ * batch_) {
+      const std::size_t bytes = std::max(kSlabSize, slot_size_ * batch_);
+      carve_ = arena_.allocate_slab(bytes);
+      carve_end_ = carve_ + bytes;
+    }
+    // 从 slab 中切出 batch_ 个相邻的 slot, 按地址顺序链接
+    void* head = carve_;
+    for (std::size_t i = 0; i + 1 < batch_; ++i) {
+      next_of(carve_ + i * slot_size_) = carve_ + (i + 1) * slot_size_;
+    }
+    next_of(carve_ + (batch_ - 1) * slot_size_) = nullptr;
+    carve_ += slot_size_ * batch_;
+    return {head, batch_};
+  }
+
+  void give(Batch b) {
+    std::lock_guard lock(mutex_);
+    batches_.push_back(b);
+  }
+
+private:
+  Arena& arena_;
+  const std::size_t slot_size_;
+  const std::size_t batch_;
+  std::mutex mutex_;
+  std::vector<Batch> batches_;
+  std::byte* carve_{nullptr};
+  std::byte* carve_end_{nullptr};
+};  // class SlabPool
+
+namespace {
+
+struct FreeList {
+  void* head{nullptr};
+  std::size_t count{0};
+  SlabPool* pool{nullptr};
+};  // struct FreeList
+
+// 一个线程对一个 Arena 的缓存
+struct CacheEntry {
+  std::uint64_t uid{0};  // 0 表示空
+  std::vector<FreeList> lists;  // 下标是 type_id
+};  // struct CacheEntry
+
+// 每个线程同时缓存最多 kCachedArenas 个 Arena
+class ThreadCache {
+public:
+  static constexpr std::size_t kCachedArenas = 4;
+
+  ~ThreadCache() {
+    for (auto& e : entries_) {
+      flush(e);
+    }
+  }
+
+  CacheEntry& entry(std::uint64_t uid) {
+    if (entries_[last_].uid == uid) {
+      return entries_[last_];
+    }
+    for (std::size_t i = 0; i < kCachedArenas; ++i) {
+      if (entries_[i].uid == uid) {
+        last_ = i;
+        return entries_[i];
+      }
+    }
+    // 优先使用空的位置, 否则轮流淘汰
+    std::size_t victim = kCachedArenas;
+    for (std::size_t i = 0; i < kCachedArenas && victim == kCachedArenas; ++i) {
+      if (entries_[i].uid == 0) {
+        victim = i;
+      }
+    }
+    if (victim == kCachedArenas) {
+      victim = next_victim_;
+      next_victim_ = (next_victim_ + 1) % kCachedArenas;
+      flush(entries_[victim]);
+    }
+    entries_[victim].uid = uid;
+    last_ = victim;
+    return entries_[victim];
+  }
+
+private:
+  // 还给仍然存活的 Arena; Arena 已经析构或者 reset() 时直接丢弃, 那些内存已经释放了
+  static void flush(CacheEntry& e) {
+    if (e.uid != 0) {
+      auto& r = registry();
+      std::lock_guard lock(r.mutex);
+      if (r.arenas.contains(e.uid)) {
+        for (auto& list : e.lists) {
+          if (list.count > 0) {
+            list.pool->give({list.head, list.count});
+          }
+        }
+      }
+    }
+    e.uid = 0;
+    e.lists.clear();
+  }
+
+  std::array<CacheEntry, kCachedArenas> entries_;
+  std::size_t last_{0};
+  std::size_t next_victim_{0};
+};  // class ThreadCache
+
+thread_local ThreadCache t_cache;
+
+FreeList& local_list(std::uint64_t uid, std::size_t type) {
+  auto& lists = t_cache.entry(uid).lists;
+  if (type >= lists.size()) {
+    lists.resize(type + 1);
+  }
+  return lists[type];
+}
+
+}  // namespace
+
+}  // namespace detail
+
+Arena::Arena() {
+  auto& r = detail::registry();
+  std::lock_guard lock(r.mutex);
+  uid_ = r.next_uid++;
+  r.arenas.emplace(uid_, this);
+}
+
+Arena::~Arena() {
+  auto& r = detail::registry();
+  std::lock_guard lock(r.mutex);
+  r.arenas.erase(uid_);
+}
+
+void* Arena::allocate(std::size_t type, std::size_t slot_size) {
+  auto& list = detail::local_list(uid_, type);
+  if (list.head == nullptr) [[unlikely]] {
+    if (list.pool == nullptr) {
+      list.pool = pool(type, slot_size);
+    }
+    const auto b = list.pool->take();
+    list.head = b.head;
+    list.count = b.count;
+  }
+  void* p = list.head;
+  list.head = detail::next_of(p);
+  --list.count;
+  return p;
+}
+
+void Arena::deallocate(void* p, std::size_t type, std::size_t slot_size) {
+  if (p == nullptr) {
+    return;
+  }
+  auto& list = detail::local_list(uid_, type);
+  if (list.pool == nullptr) {
+    list.pool = pool(type, slot_size);
+  }
+  detail::next_of(p) = list.head;
+  list.head = p;
+  const std::size_t batch = list.pool->batch();
+  if (++list.count >= 2 * batch) [[unlikely]] {
+    // 把链表头部的一批还回去
+    void* head = list.head;
+    void* tail = head;
+    for (std::size_t i = 1; i < batch; ++i) {
+      tail = detail::next_of(tail);
+    }
+    list.head = detail::next_of(tail);
+    detail::next_of(tail) = nullptr;
+    list.count -= batch;
+    list.pool->give({head, batch});
+  }
+}
+
+detail::SlabPool* Arena::pool(std::size_t type, std::size_t slot_size) {
+  std::lock_guard lock(mutex_);
+  if (type >= pools_.size()) {
+    pools_.resize(type + 1);
+  }
+  if (!pools_[type]) {
+    pools_[type] = std::make_unique<detail::SlabPool>(*this, slot_size);
+  }
+  return pools_[type].get();
+}
+
+std::byte* Arena::allocate_slab(std::size_t bytes) {
+  std::lock_guard lock(mutex_);
+  if (static_cast<std::size_t>(bump_end_ - bump_) < bytes) {
+    const std::size_t size = std::max(kBlockSize, bytes);
+    auto* block = static_cast<std::byte*>(::operator new(size, std::align_val_t{kMaxAlign}));
+    blocks_.emplace_back(block);
+    bump_ = block;
+    bump_end_ = block + size;
+    reserved_ += size;
+  }
+  std::byte* slab = bump_;
+  // 下一个 slab 仍然按 kMaxAlign 对齐
+  bump_ += (bytes + kMaxAlign - 1) / kMaxAlign * kMaxAlign;
+  bump_ = std::min(bump_, bump_end_);
+  return slab;
+}
+
+void Arena::reset() {
+  {
+    auto& r = detail::registry();
+    std::lock_guard lock(r.mutex);
+    r.arenas.erase(uid_);
+    uid_ = r.next_uid++;
+    r.arenas.emplace(uid_, this);
+  }
+  std::lock_guard lock(mutex_);
+  pools_.clear();
+  blocks_.clear();
+  bump_ = bump_end_ = nullptr;
+  reserved_ = 0;
+}
+
+std::size_t Arena::bytes_reserved() const {
+  std::lock_guard lock(mutex_);
+  return reserved_;
+}
+
+}  // namespace arena
@@ -0,0 +1,130 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 09:12:36
+# Desc   : arena::Arena: Collection::alloc<T>() 背后的按类型分 slab、带线程缓存的分配器
+########################################################################
+*/
+/*
+12.1 的 Collection::alloc<T>() 是一个类内定义的成员函数模板, 这里让它真正分配内存
+1. 内存层次
+   a. block: Arena 一次向系统申请 kBlockSize(1 MiB)的大块, 所有类型共享, 按 bump 的方式切出 slab
+   b. slab: 每种类型 T 有自己的 SlabPool, 从 block 中切出 slab(至少 kSlabSize), 再把 slab 切成大小相同的 slot
+   c. 线程缓存: 每个线程对每个 (Arena, T) 有一个无锁的空闲链表, alloc / dealloc 通常只访问这个链表
+2. 线程缓存为空时从 SlabPool 一次取一批(batch, 约 kBatchBytes 字节的 slot), 空闲超过两批时一次还回一批
+   SlabPool 的锁只在批量操作时使用, 线程退出时缓存中剩余的 slot 还给对应的 Arena
+3. alloc<T>() 返回未初始化的内存, 和原来的 T* alloc() 一样; create<T>(args...) / destroy(p) 同时构造 / 析构
+   dealloc 可以在任何线程调用, slot 进入调用线程的缓存
+4. reset(): 一次释放 Arena 的所有内存, 适合 "一个请求内分配, 请求结束时整体释放" 的场景
+   调用 reset() 或析构 Arena 时, 不能有其他线程正在使用这个 Arena, 之前分配的对象也不再有效(不会调用析构函数)
+5. alignof(T) 不能超过 kMaxAlign(64)
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace arena {
+
+inline constexpr std::size_t kBlockSize = 1 << 20;
+inline constexpr std::size_t kSlabSize = 64 << 10;
+inline constexpr std::size_t kBatchBytes = 8 << 10;
+inline constexpr std::size_t kMaxAlign = 64;
+
+namespace detail {
+
+std::size_t next_type_id();
+
+// 每个类型一个从 0 开始的稠密编号, 作为线程缓存的下标
+// 用函数内的 static 而不是变量模板, 保证在其他静态对象的初始化中使用时也已经初始化
+template <typename T>
+std::size_t type_id() {
+  static const std::size_t id = next_type_id();
+  return id;
+}
+
+// slot 至少能放下空闲链表的指针, 并且满足 T 的对齐
+template <typename T>
+inline constexpr std::size_t slot_size =
+    (std::max(sizeof(T), sizeof(void*)) + std::max(alignof(T), alignof(void*)) - 1) /
+    std::max(alignof(T), alignof(void*)) * std::max(alignof(T), alignof(void*));
+
+class SlabPool;
+
+}  // namespace detail
+
+class Arena {
+public:
+  Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  ~Arena();
+
+  template <typename T>
+  T* alloc() {
+    static_assert(alignof(T) <= kMaxAlign, "arena::Arena: over-aligned type");
+    return static_cast<T*>(allocate(detail::type_id<T>(), detail::slot_size<T>));
+  }
+  template <typename T>
+  void dealloc(T* p) {
+    deallocate(const_cast<std::remove_cv_t<T>*>(p), detail::type_id<std::remove_cv_t<T>>(),
+        detail::slot_size<std::remove_cv_t<T>>);
+  }
+
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    T* p = alloc<T>();
+    try {
+      return std::construct_at(p, std::forward<Args>(args)...);
+    } catch (...) {
+      dealloc(p);
+      throw;
+    }
+  }
+  template <typename T>
+  void destroy(T* p) {
+    std::destroy_at(p);
+    dealloc(p);
+  }
+
+  // 释放所有内存, 之前分配的所有对象都失效
+  void reset();
+  // 向系统申请的字节数
+  std::size_t bytes_reserved() const;
+
+private:
+  friend class detail::SlabPool;
+
+  void* allocate(std::size_t type, std::size_t slot_size);
+  void deallocate(void* p, std::size_t type, std::size_t slot_size);
+  detail::SlabPool* pool(std::size_t type, std::size_t slot_size);
+  // 从 block 中切出 bytes 字节, 由 SlabPool 在持有自己的锁时调用
+  std::byte* allocate_slab(std::size_t bytes);
+
+  struct BlockDeleter {
+    void operator()(std::byte* p) const { ::operator delete(p, std::align_val_t{kMaxAlign}); }
+  };  // struct BlockDeleter
+
+  // 每次 reset() 都换一个新的 uid, 线程缓存中旧 uid 的 slot 直接丢弃
+  std::uint64_t uid_;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<std::byte[], BlockDeleter>> blocks_;
+  std::byte* bump_{nullptr};
+  std::byte* bump_end_{nullptr};
+  std::size_t reserved_{0};
+  std::vector<std::unique_ptr<detail::SlabPool>> pools_;  // 下标是 type_id
+};  // class Arena
+
+}  // namespace arena
@@ -0,0 +1,102 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 10:06:51
+# Desc   : arena::Arena 与 new / delete、malloc / free 的对比
+########################################################################
+*/
+/*
+用法: chapter_12_typed_arena_benchmark [ops] [max_threads]
+对象大小 16 / 32 / 64 / 128 / 256 字节, 线程数 1 / 2 / 4 ... max_threads(默认 32)
+每个线程反复: 分配 kLive 个对象并写入第一个字节, 再按分配的逆序全部释放
+总操作数固定为 ops(一次分配加一次释放算一次), 平均分给各个线程, 结果是每次操作的平均墙钟时间
+所有线程共享同一个 Arena, 各自使用自己的线程缓存
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <print>
+#include <thread>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "typed_arena.h"
+
+inline constexpr std::size_t kLive = 1000;
+
+template <std::size_t N>
+struct Object {
+  char bytes[N];
+};  // struct Object
+
+template <typename Alloc, typename Free>
+void churn(std::size_t ops, Alloc alloc, Free free) {
+  std::vector<void*> live(kLive);
+  for (std::size_t done = 0; done < ops; done += kLive) {
+    for (auto& p : live) {
+      p = alloc();
+      *static_cast<char*>(p) = 1;
+    }
+    utils::clobber_memory();
+    for (std::size_t i = kLive; i-- > 0;) {
+      free(live[i]);
+    }
+  }
+}
+
+template <typename Work>
+void run_threads(std::size_t threads, Work work) {
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back(work);
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+template <std::size_t N>
+void bench_size(std::size_t ops, std::size_t max_threads) {
+  using T = Object<N>;
+  arena::Arena arena;
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    const std::size_t per_thread = std::max(kLive, ops / threads);
+    const std::size_t total = per_thread * threads;
+    std::println("{} bytes, {} thread(s)", N, threads);
+    utils::run_benchmark("  new / delete", total, [&] {
+      run_threads(threads, [&] {
+        churn(per_thread, [] { return static_cast<void*>(new T); }, [](void* p) { delete static_cast<T*>(p); });
+      });
+    });
+    utils::run_benchmark("  malloc / free", total, [&] {
+      run_threads(threads, [&] {
+        churn(per_thread, [] { return std::malloc(sizeof(T)); }, [](void* p) { std::free(p); });
+      });
+    });
+    utils::run_benchmark("  arena alloc / dealloc", total, [&] {
+      run_threads(threads, [&] {
+        churn(per_thread, [&] { return static_cast<void*>(arena.alloc<T>()); },
+            [&](void* p) { arena.dealloc(static_cast<T*>(p)); });
+      });
+    });
+  }
+  std::println("  arena reserved: {} KiB", arena.bytes_reserved() >> 10);
+}
+
+int main(int argc, char** argv) {
+  const std::size_t ops = utils::arg_or(argc, argv, 1, 200'000);
+  const std::size_t max_threads = utils::arg_or(argc, argv, 2, 32);
+  bench_size<16>(ops, max_threads);
+  bench_size<32>(ops, max_threads);
+  bench_size<64>(ops, max_threads);
+  bench_size<128>(ops, max_threads);
+  bench_size<256>(ops, max_threads);
+  return 0;
+}
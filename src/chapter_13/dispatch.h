@@ -0,0 +1,164 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 17:05:29
+# Desc   : table::dispatch<kBegin, kEnd>(i, f): 把运行期的整数转换为编译期常量, 调用对应的实例
+########################################################################
+*/
+/*
+13.2 的 N::select<int I>(X*) 只能通过显式模板实参指定 I, I 必须是编译期常量
+很多内核按一个小整数特化(向量宽度、通道数), 但这个整数只有运行期才知道, 需要一个从运行期到编译期的分派:
+1. dispatch<kBegin, kEnd>(i, f): i 在 [kBegin, kEnd) 中, 调用 f(std::integral_constant<T, i>{})
+   f 通常是泛型 lambda [](auto ic) { kernel<ic>(...); }, ic 可以直接作为模板实参
+   为每个值生成一个实例, 放进一个 constexpr 的函数指针表, 分派只是一次下标访问 + 一次间接调用
+2. dispatch<range<B0, E0>, range<B1, E1>, ...>(i0, i1, ..., f): 多维分派, 调用 f(ic0, ic1, ...)
+   所有维度按行优先展开成一张表(大小是各维大小的乘积), 仍然只有一次间接调用, 而不是逐维嵌套分派
+3. dispatch_switch<kBegin, kEnd>(i, f): 一维的另一种实现, 生成 if (i == kBegin) ... else if ... 的链,
+   编译器会把它转换为 switch 的跳转表, 并且可以把 f 的各个实例内联到调用处(代码更大)
+4. 返回值是各个实例返回类型的公共类型; i 超出范围时抛出 std::out_of_range
+*/
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace table {
+
+template <auto kBegin, auto kEnd>
+struct range {
+  using value_type = std::common_type_t<decltype(kBegin), decltype(kEnd)>;
+  static_assert(std::is_integral_v<value_type> && kBegin < kEnd, "table::range: empty or non-integral range");
+  static constexpr value_type begin = kBegin;
+  static constexpr value_type end = kEnd;
+  static constexpr std::size_t size = static_cast<std::size_t>(end - begin);
+};  // struct range
+
+namespace detail {
+
+template <typename T>
+struct is_range : std::false_type {};
+template <auto kBegin, auto kEnd>
+struct is_range<range<kBegin, kEnd>> : std::true_type {};
+
+template <typename... Ranges>
+struct Grid {
+  static constexpr std::array<std::size_t, sizeof...(Ranges)> sizes{Ranges::size...};
+  static constexpr std::size_t total = (Ranges::size * ...);
+
+  // 第 D 维的步长: 后面各维大小的乘积
+  static constexpr std::size_t stride(std::size_t d) {
+    std::size_t s = 1;
+    for (std::size_t k = d + 1; k < sizes.size(); ++k) {
+      s *= sizes[k];
+    }
+    return s;
+  }
+  // 展开后的下标 K 在第 D 维上的坐标
+  static constexpr std::size_t coordinate(std::size_t k, std::size_t d) { return k / stride(d) % sizes[d]; }
+
+  template <typename F, std::size_t K, std::size_t... Ds>
+  static decltype(auto) call(F& f, std::index_sequence<Ds...>) {
+    using Dims = std::tuple<Ranges...>;
+    return f(std::integral_constant<typename std::tuple_element_t<Ds, Dims>::value_type,
+        static_cast<typename std::tuple_element_t<Ds, Dims>::value_type>(
+            std::tuple_element_t<Ds, Dims>::begin + coordinate(K, Ds))>{}...);
+  }
+
+  template <typename F, std::size_t K>
+  using result_at = decltype(call<F, K>(std::declval<F&>(), std::index_sequence_for<Ranges...>{}));
+
+  template <typename F, typename Ks>
+  struct Result;
+  template <typename F, std::size_t... Ks>
+  struct Result<F, std::index_sequence<Ks...>> {
+    using type = std::common_type_t<result_at<F, Ks>...>;
+  };  // struct Result
+  template <typename F>
+  using result_t = typename Result<F, std::make_index_sequence<total>>::type;
+
+  template <typename F, std::size_t K>
+  static result_t<F> thunk(F& f) {
+    return call<F, K>(f, std::index_sequence_for<Ranges...>{});
+  }
+
+  template <typename F, std::size_t... Ks>
+  static constexpr auto make_table(std::index_sequence<Ks...>) {
+    return std::array<result_t<F> (*)(F&), total>{&thunk<F, Ks>...};
+  }
+  template <typename F>
+  static constexpr auto kTable = make_table<F>(std::make_index_sequence<total>{});
+
+  // 各维的运行期值转换为展开后的下标
+  template <std::integral... Is>
+  static std::size_t flatten(Is... is) {
+    if (!(in_bounds<Ranges>(is) && ...)) [[unlikely]] {
+      throw std::out_of_range("table::dispatch: index out of range");
+    }
+    std::size_t flat = 0;
+    ((flat = flat * Ranges::size + (static_cast<std::size_t>(is) - static_cast<std::size_t>(Ranges::begin))), ...);
+    return flat;
+  }
+
+  template <typename R, typename I>
+  static bool in_bounds(I i) {
+    return std::cmp_greater_equal(i, R::begin) && std::cmp_less(i, R::end);
+  }
+};  // struct Grid
+
+template <auto kValue, auto kEnd, typename F, typename I>
+decltype(auto) switch_chain(I i, F& f) {
+  using T = std::common_type_t<decltype(kValue), decltype(kEnd)>;
+  if constexpr (kValue + 1 == kEnd) {
+    return f(std::integral_constant<T, kValue>{});
+  } else {
+    using R = std::common_type_t<decltype(f(std::integral_constant<T, kValue>{})),
+        decltype(switch_chain<kValue + 1, kEnd>(i, f))>;
+    if (std::cmp_equal(i, kValue)) {
+      return static_cast<R>(f(std::integral_constant<T, kValue>{}));
+    }
+    return static_cast<R>(switch_chain<kValue + 1, kEnd>(i, f));
+  }
+}
+
+}  // namespace detail
+
+// 多维: dispatch<range<B0, E0>, range<B1, E1>>(i0, i1, f)
+template <typename... Ranges, typename... Args>
+  requires(sizeof...(Ranges) > 0 && (detail::is_range<Ranges>::value && ...) && sizeof...(Args) == sizeof...(Ranges) + 1)
+decltype(auto) dispatch(Args&&... args) {
+  using Grid = detail::Grid<Ranges...>;
+  auto refs = std::forward_as_tuple(args...);
+  auto& f = std::get<sizeof...(Ranges)>(refs);
+  using F = std::remove_reference_t<decltype(f)>;
+  const std::size_t flat = [&]<std::size_t... Ds>(std::index_sequence<Ds...>) {
+    return Grid::flatten(std::get<Ds>(refs)...);
+  }(std::index_sequence_for<Ranges...>{});
+  return Grid::template kTable<F>[flat](f);
+}
+
+// 一维: dispatch<kBegin, kEnd>(i, f)
+template <auto kBegin, auto kEnd, std::integral I, typename F>
+decltype(auto) dispatch(I i, F&& f) {
+  return dispatch<range<kBegin, kEnd>>(i, f);
+}
+
+template <auto kBegin, auto kEnd, std::integral I, typename F>
+decltype(auto) dispatch_switch(I i, F&& f) {
+  static_assert(kBegin < kEnd, "table::dispatch_switch: empty range");
+  if (std::cmp_less(i, kBegin) || std::cmp_greater_equal(i, kEnd)) [[unlikely]] {
+    throw std::out_of_range("table::dispatch_switch: index out of range");
+  }
+  return detail::switch_chain<kBegin, kEnd>(i, f);
+}
+
+}  // namespace table
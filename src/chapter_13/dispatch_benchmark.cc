@@ -0,0 +1,156 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 17:41:06
+# Desc   : table::dispatch 与手写 switch、运行期参数的对比
+########################################################################
+*/
+/*
+用法: chapter_13_dispatch_benchmark [calls] [frames]
+内核按通道数 C(1 ~ 8)特化, 四种调用方式:
+  table::dispatch: 函数指针表
+  table::dispatch_switch: 编译器生成的 switch
+  hand-written switch: case 1: kernel<1>(...); ...
+  runtime parameter: 通道数作为普通参数传给同一个非模板的内核
+1. tiny kernel: 内核只有几条指令, 每次调用的 C 随机, 测的是分派本身的开销(以及间接跳转的预测失败)
+2. channel sums: 交错存放的多通道采样按通道求和, frames 帧, C 是编译期常量时内层循环可以完全展开
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+#include "dispatch.h"
+
+inline constexpr int kMaxChannels = 8;
+
+template <int C>
+UTILS_NOINLINE std::uint64_t tiny(std::uint64_t x) {
+  return x * C + (C >> 1);
+}
+UTILS_NOINLINE std::uint64_t tiny(std::uint64_t x, int c) {
+  return x * static_cast<std::uint64_t>(c) + static_cast<std::uint64_t>(c >> 1);
+}
+
+template <int C>
+UTILS_NOINLINE void channel_sums(const float* data, std::size_t frames, float* out) {
+  std::array<float, C> sums{};
+  for (std::size_t f = 0; f < frames; ++f) {
+    for (int c = 0; c < C; ++c) {
+      sums[c] += data[f * C + c];
+    }
+  }
+  for (int c = 0; c < C; ++c) {
+    out[c] = sums[c];
+  }
+}
+UTILS_NOINLINE void channel_sums(const float* data, std::size_t frames, int channels, float* out) {
+  std::array<float, kMaxChannels> sums{};
+  for (std::size_t f = 0; f < frames; ++f) {
+    for (int c = 0; c < channels; ++c) {
+      sums[c] += data[f * channels + c];
+    }
+  }
+  for (int c = 0; c < channels; ++c) {
+    out[c] = sums[c];
+  }
+}
+
+std::uint64_t tiny_switch(std::uint64_t x, int c) {
+  switch (c) {
+    case 1: return tiny<1>(x);
+    case 2: return tiny<2>(x);
+    case 3: return tiny<3>(x);
+    case 4: return tiny<4>(x);
+    case 5: return tiny<5>(x);
+    case 6: return tiny<6>(x);
+    case 7: return tiny<7>(x);
+    case 8: return tiny<8>(x);
+    default: return 0;
+  }
+}
+
+void sums_switch(const float* data, std::size_t frames, int c, float* out) {
+  switch (c) {
+    case 1: return channel_sums<1>(data, frames, out);
+    case 2: return channel_sums<2>(data, frames, out);
+    case 3: return channel_sums<3>(data, frames, out);
+    case 4: return channel_sums<4>(data, frames, out);
+    case 5: return channel_sums<5>(data, frames, out);
+    case 6: return channel_sums<6>(data, frames, out);
+    case 7: return channel_sums<7>(data, frames, out);
+    case 8: return channel_sums<8>(data, frames, out);
+    default: return;
+  }
+}
+
+template <typename Call>
+void bench_tiny(const char* name, const std::vector<int>& channels, Call call) {
+  utils::run_benchmark(name, channels.size(), [&] {
+    std::uint64_t s = 0;
+    for (int c : channels) {
+      s += call(s, c);
+    }
+    utils::do_not_optimize(s);
+  });
+}
+
+template <typename Call>
+void bench_sums(const char* name, const std::vector<float>& data, std::size_t frames, Call call) {
+  std::array<float, kMaxChannels> out{};
+  // 每轮处理 1 + 2 + ... + kMaxChannels 个通道, 结果是每个采样的时间
+  utils::run_benchmark(name, frames * kMaxChannels * (kMaxChannels + 1) / 2, [&] {
+    for (int c = 1; c <= kMaxChannels; ++c) {
+      call(data.data(), frames, c, out.data());
+      utils::do_not_optimize(out);
+    }
+  });
+}
+
+int main(int argc, char** argv) {
+  const std::size_t calls = utils::arg_or(argc, argv, 1, 10'000'000);
+  const std::size_t frames = utils::arg_or(argc, argv, 2, 1 << 18);
+
+  std::vector<int> channels(calls);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(1, kMaxChannels);
+  for (auto& c : channels) {
+    c = dist(rng);
+  }
+  std::println("tiny kernel, {} calls, random channels", calls);
+  bench_tiny("  table::dispatch", channels, [](std::uint64_t x, int c) {
+    return table::dispatch<1, kMaxChannels + 1>(c, [x](auto ic) { return tiny<ic>(x); });
+  });
+  bench_tiny("  table::dispatch_switch", channels, [](std::uint64_t x, int c) {
+    return table::dispatch_switch<1, kMaxChannels + 1>(c, [x](auto ic) { return tiny<ic>(x); });
+  });
+  bench_tiny("  hand-written switch", channels, [](std::uint64_t x, int c) { return tiny_switch(x, c); });
+  bench_tiny("  runtime parameter", channels, [](std::uint64_t x, int c) { return tiny(x, c); });
+
+  // 按最多的通道数分配, 每种通道数都处理 frames 帧
+  std::vector<float> data(frames * kMaxChannels);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 17);
+  }
+  std::println("channel sums, {} frames, channels 1 ~ {}", frames, kMaxChannels);
+  bench_sums("  table::dispatch", data, frames, [](const float* d, std::size_t n, int c, float* out) {
+    table::dispatch<1, kMaxChannels + 1>(c, [&](auto ic) { channel_sums<ic>(d, n, out); });
+  });
+  bench_sums("  table::dispatch_switch", data, frames, [](const float* d, std::size_t n, int c, float* out) {
+    table::dispatch_switch<1, kMaxChannels + 1>(c, [&](auto ic) { channel_sums<ic>(d, n, out); });
+  });
+  bench_sums("  hand-written switch", data, frames, sums_switch);
+  bench_sums("  runtime parameter", data, frames,
+      [](const float* d, std::size_t n, int c, float* out) { channel_sums(d, n, c, out); });
+  return 0;
+}
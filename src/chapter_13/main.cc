@@ -14,8 +14,11 @@
 // 13.1 名称的分类
 
 // 13.2 名称查找
+#include <cassert>
 #include <print>
 #include "cpp_utils/util.h"
+
+#include "dispatch.h"
 int x;
 class B {
 public:
@@ -252,6 +255,24 @@ void gg(N::X* xp) {
 
 }
 
+// select<I> 的 I 只能是编译期常量, 运行期的 i 需要先分派到对应的实例, 见 dispatch.h
+void run_dispatch() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  N::X x;
+  for (int i : {0, 3, 7}) {
+    table::dispatch<0, 8>(i, [&](auto ic) { select<ic>(&x); });
+  }
+  // 二维: 通道数 [1, 5) 和 log2(向量宽度) [0, 4)
+  const int channels = 3;
+  const int log2_width = 2;
+  const int lanes = table::dispatch<table::range<1, 5>, table::range<0, 4>>(channels, log2_width,
+      [](auto c, auto w) { return c * (1 << w); });
+  const int same = table::dispatch_switch<1, 5>(channels, [&](auto c) { return c * (1 << log2_width); });
+  assert(lanes == same);
+  std::println("lanes = {}", lanes);
+  std::println();
+}
+
 // 13.3.6 依赖型表达式
 // 表达式依赖于模板参数, 依赖模板参数的表达式在不同的实例化中的行为有可能不同
 /*
@@ -386,6 +407,7 @@ int main() {
   run_class_name_injection();
   run_type_dependent();
   run_dependent_base();
+  run_dispatch();
   return 0;
 }
 
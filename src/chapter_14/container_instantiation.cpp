@@ -0,0 +1,31 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 18:20:03
+# Desc   :
+########################################################################
+*/
+
+#include "container_instantiation.h"
+
+template class reloc::Vector<int>;  // 手动实例化
+template class reloc::Vector<double>;
+template class reloc::Vector<std::string>;
+template int* reloc::uninitialized_relocate_n<int>(int*, std::size_t, int*);
+template double* reloc::uninitialized_relocate_n<double>(double*, std::size_t, double*);
+template std::string* reloc::uninitialized_relocate_n<std::string>(std::string*, std::size_t, std::string*);
+
+template class slot::List<int>;
+template class slot::List<double>;
+template class slot::List<std::string>;
+
+template class pool::ObjectPool<std::string, true>;  // kPoison 的默认值取决于 NDEBUG, 两种都实例化
+template class pool::ObjectPool<std::string, false>;
+
+template class columns::soa<float, float, float>;
+template class columns::soa<int, double>;
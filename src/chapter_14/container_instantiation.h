@@ -0,0 +1,53 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 18:12:36
+# Desc   : 常用容器模板的 extern template 声明, 实例化在 chapter_14_container_instantiation 库中
+########################################################################
+*/
+/*
+和 t.h 的做法相同: 包含模板的定义, 再用 extern template 声明常用的特化, 禁止在包含这个头文件的编译单元中实例化它们
+显式实例化定义在 container_instantiation.cpp 中, 编译为 chapter_14_container_instantiation 库, 只编译一次
+1. 类模板的显式实例化会实例化所有非模板成员; 成员模板(emplace_back<Args...> 等)不在其中, 仍然在使用处实例化
+2. extern template 不影响内联: 开启优化时编译器仍然可以实例化并内联类内定义的小函数, 节省的主要是 -O0 的编译时间和重复的代码
+3. 只声明了下面列出的特化, 其他特化(例如 reloc::Vector<float>)仍然在使用处隐式实例化
+4. 新增的特化要同时加在这里和 container_instantiation.cpp 中
+5. 没有包含的容器:
+   std::vector<int> / <double> / <std::string>: 标准规定程序只能在声明依赖程序定义的类型时显式实例化标准库的类模板
+   ([namespace.std]), 所以这里实例化的是项目自己的 reloc::Vector; std::vector 的重复实例化由 libstdc++ 自己处理(例如 basic_string)
+   chapter_02 / chapter_03 / chapter_05 的 Stack<T> / Queue<T>: 定义在各章的 main.cc 中(chapter_03 的 stacknontype.h
+   只被本章的 main.cc 包含, stackauto.h 没有被使用, 两者都没有 #pragma once), 每个特化只在一个编译单元中使用, 没有可以共享的实例化
+   chapter_12 的 Stack<T> 同样定义在 main.cc 中, 它的存储 reloc::Vector<std::string> 由这里的实例化覆盖
+编译时间和目标文件大小的对比见 container_user.cc
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "chapter_11/soa.h"
+#include "chapter_12/object_pool.h"
+#include "chapter_12/relocate.h"
+#include "chapter_12/slot_map.h"
+
+extern template class reloc::Vector<int>;
+extern template class reloc::Vector<double>;
+extern template class reloc::Vector<std::string>;
+extern template int* reloc::uninitialized_relocate_n<int>(int*, std::size_t, int*);
+extern template double* reloc::uninitialized_relocate_n<double>(double*, std::size_t, double*);
+extern template std::string* reloc::uninitialized_relocate_n<std::string>(std::string*, std::size_t, std::string*);
+
+extern template class slot::List<int>;
+extern template class slot::List<double>;
+extern template class slot::List<std::string>;
+
+extern template class pool::ObjectPool<std::string, true>;
+extern template class pool::ObjectPool<std::string, false>;
+
+extern template class columns::soa<float, float, float>;
+extern template class columns::soa<int, double>;
@@ -0,0 +1,93 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 18:31:47
+# Desc   : 常用容器模板在每个编译单元中隐式实例化与 extern template 的编译时间和代码大小对比
+########################################################################
+*/
+/*
+模拟很多编译单元使用同样几个容器特化的项目: 这个文件以 CONTAINER_USER_ID = 0 ~ 7 编译 8 次, 每次定义一个 container_user_<ID>()
+1. chapter_14_container_header_only: 只包含容器的头文件, 每个编译单元都隐式实例化一遍用到的成员, 链接时再丢弃重复的副本
+2. chapter_14_container_extern: 定义 CONTAINER_EXTERN_TEMPLATE, 包含 container_instantiation.h,
+   各编译单元只引用 chapter_14_container_instantiation 库中已经实例化的成员
+对比(-O0 的 Debug 构建差别最明显, 开启优化时类内定义的小成员函数仍然会在使用处实例化并内联):
+  time make chapter_14_container_header_only
+  time make chapter_14_container_extern
+  size CMakeFiles/chapter_14_container_header_only_0.dir/chapter_14/container_user.cc.o
+  size CMakeFiles/chapter_14_container_extern_0.dir/chapter_14/container_user.cc.o
+  size output/bin/chapter_14_container_header_only output/bin/chapter_14_container_extern
+extern 的目标还要加上 chapter_14_container_instantiation 编译一次的时间, 但它只在容器的头文件修改时才重新编译
+参考数据: g++ 12.2.0, -std=c++2b, 单核, 只编译 8 个 container_user.cc 的目标文件(不含链接), 时间有 ±2 s 的波动:
+  -O0: 14 ~ 17 s -> 12 s(另加 -ffunction-sections 编译库 2 s), 每个目标文件的代码(size 的 text) 78 KB -> 18 KB
+  -O2: 编译时间没有明显差别, 每个目标文件的代码 12.1 KB -> 11.5 KB, 小成员函数仍然在使用处实例化并内联
+可执行文件的大小还取决于 std::print 的实现和链接选项, 这里不给出数字; -O2 时 extern 的版本可能更大,
+因为库中的成员是独立编译的, 没有和使用处一起内联和裁剪
+显式实例化会实例化所有的非模板成员, 包括没有用到的, 所以库本身比每个编译单元都大,
+没有 -ffunction-sections + --gc-sections 时这些成员都会留在可执行文件里
+结论: extern template 主要缩短 Debug 构建的编译时间和目标文件大小, 对优化构建的代码大小没有帮助
+*/
+
+#include <cstddef>
+#include <string>
+
+#ifdef CONTAINER_EXTERN_TEMPLATE
+#include "container_instantiation.h"
+#else
+#include "chapter_11/soa.h"
+#include "chapter_12/object_pool.h"
+#include "chapter_12/relocate.h"
+#include "chapter_12/slot_map.h"
+#endif
+
+#define CONTAINER_USER_CONCAT_(a, b) a##b
+#define CONTAINER_USER_CONCAT(a, b) CONTAINER_USER_CONCAT_(a, b)
+
+std::size_t CONTAINER_USER_CONCAT(container_user_, CONTAINER_USER_ID)(std::size_t n) {
+  std::size_t checksum = 0;
+
+  reloc::Vector<int> ints;
+  reloc::Vector<double> doubles;
+  reloc::Vector<std::string> strings;
+  for (std::size_t i = 0; i < n; ++i) {
+    ints.push_back(static_cast<int>(i));
+    doubles.push_back(static_cast<double>(i) * 0.5);
+    strings.push_back(std::to_string(i));
+  }
+  ints.erase(ints.begin());
+  strings.erase(strings.begin(), strings.begin() + static_cast<std::ptrdiff_t>(strings.size() / 2));
+  reloc::Vector<std::string> copy = strings;
+  for (int v : ints) {
+    checksum += static_cast<std::size_t>(v);
+  }
+  checksum += doubles.size() + copy.size() + (copy.empty() ? 0 : copy.back().size());
+
+  slot::List<int> handles;
+  slot::List<std::string> names;
+  auto h = handles.insert(CONTAINER_USER_ID);
+  auto name = names.insert(std::string("user"));
+  checksum += static_cast<std::size_t>(handles[h]) + names[name].size();
+  handles.erase(h);
+  checksum += handles.contains(h) ? 1 : 0;
+
+  pool::ObjectPool<std::string> string_pool;
+  std::string* s = string_pool.construct(std::to_string(n));
+  checksum += s->size() + string_pool.size();
+  string_pool.destroy(s);
+
+  columns::soa<float, float, float> points;
+  columns::soa<int, double> pairs;
+  for (std::size_t i = 0; i < n; ++i) {
+    points.push_back(1.0F, 2.0F, static_cast<float>(i));
+    pairs.push_back(static_cast<int>(i), 0.25);
+  }
+  for (auto [x, y, z] : points) {
+    checksum += static_cast<std::size_t>(x + y + z);
+  }
+  checksum += pairs.size();
+  return checksum;
+}
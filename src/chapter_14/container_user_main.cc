@@ -0,0 +1,39 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 18:44:10
+# Desc   : 调用 container_user.cc 的 8 个实例, 见 container_user.cc
+########################################################################
+*/
+/*
+用法: chapter_14_container_header_only / chapter_14_container_extern [n]
+两个可执行文件的输出相同, 对比的是它们的编译时间和代码大小:
+  size chapter_14_container_header_only chapter_14_container_extern
+*/
+
+#include <cstddef>
+#include <print>
+
+#include "utils/benchmark.h"
+
+std::size_t container_user_0(std::size_t n);
+std::size_t container_user_1(std::size_t n);
+std::size_t container_user_2(std::size_t n);
+std::size_t container_user_3(std::size_t n);
+std::size_t container_user_4(std::size_t n);
+std::size_t container_user_5(std::size_t n);
+std::size_t container_user_6(std::size_t n);
+std::size_t container_user_7(std::size_t n);
+
+int main(int argc, char** argv) {
+  const std::size_t n = utils::arg_or(argc, argv, 1, 1'000);
+  const std::size_t checksum = container_user_0(n) + container_user_1(n) + container_user_2(n) + container_user_3(n) +
+      container_user_4(n) + container_user_5(n) + container_user_6(n) + container_user_7(n);
+  std::println("checksum: {}", checksum);
+  return 0;
+}
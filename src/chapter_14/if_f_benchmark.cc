@@ -0,0 +1,325 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/20 19:06:52
+# Desc   : 14.6 的 if constexpr / DispatchIfF 与运行期分支在热循环中的对比
+########################################################################
+*/
+/*
+用法: chapter_14_if_f_benchmark [elements] [window]
+每个变体统计 elements(默认 1 亿)个元素中 if_f(p) 为 true 的个数, 数据是 window(默认 65536)个元素的数组, 重复扫描
+window 远大于分支预测器能记住的历史, 随机的数据在每一轮中都无法预测; 同时足够小, 数组留在 L2 中, 测的不是内存带宽
+元素类型:
+  Wide: 16 字节的有符号整数, 大于 long long, 走 p.compare(0) > 0 的分支
+  long long: 走 p > 0 的分支
+变体:
+  if constexpr: main.cc 的 if_f<T>, 编译期选择分支, 另一个分支不会被实例化
+  DispatchIfF: main.cc 的 if_f_2<T>, 用类模板特化在编译期选择, 生成的代码应该和 if constexpr 相同
+  runtime branch: 两个分支都编译进来, 每个元素按运行期的 small[i] 选择(模拟 "类型只有运行期才知道")
+两组数据:
+  predictable: 前一半是负数, 后一半是正数; small[i] 全部为 false
+  unpredictable: 正负随机; small[i] 随机
+输出:
+  cycles/elem 和 branch-misses: 通过 perf_event_open 读取硬件计数器(只统计用户态)
+    不可用时(没有 PMU 的虚拟机、perf_event_paranoid 过高)cycles 退化为 rdtsc 的参考周期, branch-misses 显示 n/a
+  code: 内核函数的机器码字节数, 从 /proc/self/exe 的符号表中读取, 也可以用下面的命令查看汇编:
+    nm -C --size-sort output/bin/chapter_14_if_f_benchmark | grep count_
+    objdump -d -C --no-show-raw-insn output/bin/chapter_14_if_f_benchmark
+*/
+
+#include <elf.h>
+#include <link.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "utils/benchmark.h"
+
+// 14.6 的三种写法, 和 main.cc 相同(if_f 的 else 分支补上了 return)
+template <typename T>
+bool if_f(T p) {
+  if constexpr (sizeof(T) <= sizeof(long long)) {
+    return p > 0;
+  } else {
+    return p.compare(0) > 0;
+  }
+}
+template <bool b>
+struct DispatchIfF {
+  template <typename T>
+  static bool if_f(T p) {
+    return p.compare(0) > 0;
+  }
+};  // struct DispatchIfF
+template <>
+struct DispatchIfF<true> {
+  template <typename T>
+  static bool if_f(T p) {
+    return p > 0;
+  }
+};  // struct DispatchIfF<true>
+template <typename T>
+bool if_f_2(T p) {
+  return DispatchIfF<sizeof(T) <= sizeof(long long)>::if_f(p);
+}
+
+// 128 位有符号整数, hi 是高 64 位(符号扩展), lo 是低 64 位
+struct Wide {
+  std::int64_t hi;
+  std::uint64_t lo;
+
+  int compare(long long v) const {
+    const std::int64_t v_hi = v < 0 ? -1 : 0;
+    if (hi != v_hi) {
+      return hi < v_hi ? -1 : 1;
+    }
+    const auto v_lo = static_cast<std::uint64_t>(v);
+    return lo < v_lo ? -1 : (lo > v_lo ? 1 : 0);
+  }
+};  // struct Wide
+
+// 运行期分支: small 为 true 时只看低 64 位(相当于 if_f<long long>)
+inline bool if_f_runtime(const Wide& p, bool small) {
+  if (small) {
+    return static_cast<long long>(p.lo) > 0;
+  }
+  return p.compare(0) > 0;
+}
+
+// 被测的内核, 不内联, 这样才能按符号统计代码大小
+UTILS_NOINLINE std::size_t count_if_constexpr(const Wide* data, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += if_f(data[i]);
+  }
+  return count;
+}
+UTILS_NOINLINE std::size_t count_dispatch(const Wide* data, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += if_f_2(data[i]);
+  }
+  return count;
+}
+UTILS_NOINLINE std::size_t count_runtime(const Wide* data, const bool* small, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += if_f_runtime(data[i], small[i]);
+  }
+  return count;
+}
+UTILS_NOINLINE std::size_t count_if_constexpr_small(const long long* data, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += if_f(data[i]);
+  }
+  return count;
+}
+UTILS_NOINLINE std::size_t count_dispatch_small(const long long* data, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += if_f_2(data[i]);
+  }
+  return count;
+}
+
+// perf_event_open 打开的一组计数器: cycles(组长)和 branch-misses
+class PerfCounters {
+public:
+  struct Sample {
+    std::uint64_t cycles;
+    std::optional<std::uint64_t> branch_misses;  // 没有硬件计数器时为空
+  };  // struct Sample
+
+  PerfCounters() {
+    leader_ = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader_ >= 0) {
+      misses_ = open(PERF_COUNT_HW_BRANCH_MISSES, leader_);
+      if (misses_ < 0) {
+        ::close(leader_);
+        leader_ = -1;
+      }
+    }
+  }
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  ~PerfCounters() {
+    if (leader_ >= 0) {
+      ::close(misses_);
+      ::close(leader_);
+    }
+  }
+
+  bool available() const { return leader_ >= 0; }
+
+  void start() {
+    if (available()) {
+      ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    } else {
+      tsc_ = tsc();
+    }
+  }
+  Sample stop() {
+    if (!available()) {
+      return {tsc() - tsc_, std::nullopt};
+    }
+    ::ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // PERF_FORMAT_GROUP: 计数器的个数, 然后按打开的顺序排列的值
+    std::array<std::uint64_t, 3> values{};
+    if (::read(leader_, values.data(), sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+      return {0, std::nullopt};
+    }
+    return {values[1], values[2]};
+  }
+
+private:
+  static int open(std::uint64_t config, int group) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+  }
+
+  static std::uint64_t tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  }
+
+  int leader_{-1};
+  int misses_{-1};
+  std::uint64_t tsc_{0};
+};  // class PerfCounters
+
+// 函数 fn 在 /proc/self/exe 的符号表中记录的大小(字节), 找不到(例如可执行文件被 strip)时返回 0
+std::size_t code_size(const void* fn) {
+  std::ifstream file("/proc/self/exe", std::ios::binary);
+  const std::vector<char> image{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  if (image.size() < sizeof(Elf64_Ehdr)) {
+    return 0;
+  }
+  const auto* ehdr = reinterpret_cast<const Elf64_Ehdr*>(image.data());
+  if (ehdr->e_ident[EI_CLASS] != ELFCLASS64 || ehdr->e_shoff + ehdr->e_shnum * sizeof(Elf64_Shdr) > image.size()) {
+    return 0;
+  }
+  // 主程序是 dl_iterate_phdr 回调的第一个对象, dlpi_addr 是它的加载偏移(非 PIE 时为 0)
+  std::uintptr_t bias = 0;
+  dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* data) {
+    *static_cast<std::uintptr_t*>(data) = info->dlpi_addr;
+    return 1;
+  }, &bias);
+  const auto address = reinterpret_cast<std::uintptr_t>(fn) - bias;
+  const auto* sections = reinterpret_cast<const Elf64_Shdr*>(image.data() + ehdr->e_shoff);
+  for (std::size_t s = 0; s < ehdr->e_shnum; ++s) {
+    if (sections[s].sh_type != SHT_SYMTAB || sections[s].sh_offset + sections[s].sh_size > image.size()) {
+      continue;
+    }
+    const auto* symbols = reinterpret_cast<const Elf64_Sym*>(image.data() + sections[s].sh_offset);
+    for (std::size_t k = 0; k < sections[s].sh_size / sizeof(Elf64_Sym); ++k) {
+      if (ELF64_ST_TYPE(symbols[k].st_info) == STT_FUNC && symbols[k].st_value == address) {
+        return symbols[k].st_size;
+      }
+    }
+  }
+  return 0;
+}
+
+struct Data {
+  std::vector<Wide> wide;
+  std::vector<long long> narrow;  // wide 的低 64 位
+  std::unique_ptr<bool[]> small;
+};  // struct Data
+
+Data make_data(std::size_t window, bool predictable) {
+  Data data{std::vector<Wide>(window), std::vector<long long>(window), std::make_unique<bool[]>(window)};
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<long long> magnitude(1, 1LL << 62);
+  for (std::size_t i = 0; i < window; ++i) {
+    const bool positive = predictable ? i >= window / 2 : (rng() & 1) != 0;
+    const long long v = positive ? magnitude(rng) : -magnitude(rng);
+    data.wide[i] = Wide{v < 0 ? -1 : 0, static_cast<std::uint64_t>(v)};
+    data.narrow[i] = v;
+    data.small[i] = predictable ? false : (rng() & 1) != 0;
+  }
+  return data;
+}
+
+// 扫描 window 个元素的数组直到处理完 elements 个元素, 先扫描一遍预热(cache 和分支预测器)
+template <typename Kernel>
+void bench(const char* name, const void* fn, std::size_t elements, std::size_t window, Kernel kernel) {
+  const std::size_t passes = std::max<std::size_t>(1, elements / window);
+  const double n = static_cast<double>(passes * window);
+  utils::do_not_optimize(kernel());
+  PerfCounters counters;
+  std::size_t count = 0;
+  utils::Stopwatch watch;
+  counters.start();
+  for (std::size_t p = 0; p < passes; ++p) {
+    count += kernel();
+    utils::clobber_memory();
+  }
+  const auto sample = counters.stop();
+  const double ns = watch.elapsed_ns();
+  utils::do_not_optimize(count);
+  const std::string misses = sample.branch_misses
+      ? std::format("{:>12} branch-misses ({:.4f}/elem)", *sample.branch_misses, static_cast<double>(*sample.branch_misses) / n)
+      : std::format("{:>12} branch-misses", "n/a");
+  std::println("{:<32} {:>8.3f} ns/elem {:>8.3f} {}/elem {} {:>5} B code", name, ns / n,
+      static_cast<double>(sample.cycles) / n, counters.available() ? "cycles" : "tsc", misses, code_size(fn));
+}
+
+int main(int argc, char** argv) {
+  const std::size_t elements = utils::arg_or(argc, argv, 1, 100'000'000);
+  const std::size_t window = std::max<std::size_t>(1, utils::arg_or(argc, argv, 2, 1 << 16));
+  std::println("elements: {}, window: {}, perf counters: {}", elements, window,
+      PerfCounters().available() ? "available" : "unavailable, fallback to rdtsc");
+  for (const bool predictable : {true, false}) {
+    const Data data = make_data(window, predictable);
+    const Wide* wide = data.wide.data();
+    const long long* narrow = data.narrow.data();
+    const bool* small = data.small.get();
+    std::println("{}", predictable ? "predictable" : "unpredictable");
+    bench("  if constexpr<Wide>", reinterpret_cast<const void*>(&count_if_constexpr), elements, window,
+        [&] { return count_if_constexpr(wide, window); });
+    bench("  DispatchIfF<Wide>", reinterpret_cast<const void*>(&count_dispatch), elements, window,
+        [&] { return count_dispatch(wide, window); });
+    bench("  runtime branch<Wide>", reinterpret_cast<const void*>(&count_runtime), elements, window,
+        [&] { return count_runtime(wide, small, window); });
+    bench("  if constexpr<long long>", reinterpret_cast<const void*>(&count_if_constexpr_small), elements, window,
+        [&] { return count_if_constexpr_small(narrow, window); });
+    bench("  DispatchIfF<long long>", reinterpret_cast<const void*>(&count_dispatch_small), elements, window,
+        [&] { return count_dispatch_small(narrow, window); });
+  }
+  return 0;
+}
@@ -16,8 +16,10 @@ template argument deduction
 #include <print>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <cxxabi.h>
 #include "cpp_utils/util.h"
+#include "utils/lifetime_probe.h"
 
 // 15.1 推导的过程
 template <typename T>
@@ -231,6 +233,30 @@ typename std::enable_if_t<!std::is_lvalue_reference_v<T>> rvalue(T&&) {
   PRINT_CURRENT_FUNCTION_NAME;
 }
 
+// 使用 lifetime probe 验证完美转发不会产生额外的拷贝
+template <typename Sink, typename T>
+void forward_to_sink(Sink& sink, T&& x) {
+  sink.push_back(std::forward<T>(x));
+}
+void run_perfect_forwarding_probe() {
+  PRINT_CURRENT_FUNCTION_NAME;
+  using Probe = utils::LifetimeProbe<struct ForwardProbeTag>;
+  std::vector<Probe> sink;
+  sink.reserve(3);
+  Probe v{1};
+  const Probe c{2};
+  {
+    utils::LifetimeScope<struct ForwardProbeTag> scope;
+    forward_to_sink(sink, v);  // T = Probe&, 拷贝
+    forward_to_sink(sink, c);  // T = const Probe&, 拷贝
+    forward_to_sink(sink, std::move(v));  // T = Probe, 移动
+    assert(2 == scope.counts().copies());
+    assert(1 == scope.counts().moves());
+  }
+  utils::print_lifetime_report();
+  std::println();
+}
+
 void run_perfect_forwarding() {
   PRINT_CURRENT_FUNCTION_NAME;
   C v;
@@ -922,6 +948,7 @@ int main() {
   run_reference_collapse();
   run_forward_reference();
   run_perfect_forwarding();
+  run_perfect_forwarding_probe();
   run_limitation_of_deduction();
   run_explicit_template_argument();
   run_auto();
@@ -0,0 +1,101 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 11:03:47
+# Desc   : 简单的基准测试工具, 用于各章节的 *_benchmark 可执行文件
+########################################################################
+*/
+/*
+项目里没有引入 google benchmark(见根目录 CMakeLists.txt 中被注释的部分)，这里只提供最基本的计时功能
+1. do_not_optimize / clobber_memory: 防止编译器把被测代码优化掉
+2. Stopwatch: 基于 std::chrono::steady_clock 的计时器
+3. run_benchmark: 重复执行若干次，取最快的一次，输出 ns/op
+4. arg_or: 从命令行读取规模参数, run.sh 会不带参数执行所有程序，所以默认规模都比较小
+*/
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <print>
+#include <string>
+#include <string_view>
+
+// 被测函数不内联，也不做跨过程优化(gcc 的 isra 等会改写参数传递方式)
+#if defined(__clang__)
+#define UTILS_NOINLINE __attribute__((noinline))
+#else
+#define UTILS_NOINLINE __attribute__((noipa))
+#endif
+
+namespace utils {
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+template <typename T>
+inline void do_not_optimize(T& value) {
+  asm volatile("" : "+r,m"(value) : : "memory");
+}
+inline void clobber_memory() {
+  asm volatile("" : : : "memory");
+}
+
+class Stopwatch {
+public:
+  using Clock = std::chrono::steady_clock;
+  Stopwatch() : start_(Clock::now()) {}
+  void reset() { start_ = Clock::now(); }
+  double elapsed_ns() const {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start_).count();
+  }
+private:
+  Clock::time_point start_;
+};  // class Stopwatch
+
+struct BenchmarkResult {
+  std::string name;
+  std::size_t ops{0};
+  double ns{0.0};
+  double ns_per_op() const { return ops == 0 ? 0.0 : ns / static_cast<double>(ops); }
+  double ops_per_second() const { return ns == 0.0 ? 0.0 : static_cast<double>(ops) * 1e9 / ns; }
+};  // struct BenchmarkResult
+
+inline void print_result(const BenchmarkResult& r) {
+  std::println("{:<56} {:>12.3f} ns/op {:>14.0f} op/s", r.name, r.ns_per_op(), r.ops_per_second());
+}
+
+// f 每次执行 ops 次操作, 执行 repeats 次并取最快的一次
+template <typename F>
+BenchmarkResult run_benchmark(std::string_view name, std::size_t ops, F&& f, int repeats = 3) {
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < repeats; ++i) {
+    Stopwatch watch;
+    f();
+    clobber_memory();
+    best = std::min(best, watch.elapsed_ns());
+  }
+  BenchmarkResult result{std::string(name), ops, best};
+  print_result(result);
+  return result;
+}
+
+inline std::size_t arg_or(int argc, char** argv, int index, std::size_t default_value) {
+  if (index >= argc) {
+    return default_value;
+  }
+  std::string_view arg(argv[index]);
+  std::size_t value = default_value;
+  auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  return ec == std::errc() ? value : default_value;
+}
+
+}  // namespace utils
@@ -0,0 +1,324 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 10:12:31
+# Desc   : lifetime probe: 统计构造、拷贝、移动、赋值、析构和堆分配次数
+########################################################################
+*/
+/*
+用法:
+1. LifetimeProbe<Tag>: 一个可以直接使用的探针类型, 内部只有一个 int
+2. Probed<T, Tag>: 包装已有类型 T, 比如 Probed<std::string> 可以替换 Person 中的 std::string name
+3. LifetimeScope<Tag>: RAII, 统计作用域内(调用点)的计数增量, 析构时汇总到报告中
+4. lifetime_report() / print_lifetime_report(): 按调用点输出汇总结果
+
+所有计数都是原子的(relaxed), 多线程下也可以汇总
+Tag 相同的类型共享同一组计数器
+
+如果需要统计全局的 operator new 次数(比如 std::string 内部的分配), 在且只在一个编译单元中
+#define UTILS_LIFETIME_PROBE_REPLACE_GLOBAL_NEW
+#include "utils/lifetime_probe.h"
+LifetimeScope::heap_allocations() 返回本线程在作用域内的全局分配次数
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <mutex>
+#include <new>
+#include <print>
+#include <source_location>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+struct LifetimeCounts {
+  std::size_t default_constructions{0};
+  std::size_t value_constructions{0};  // 由非同类型参数构造, 比如 Probed<std::string>("tmp")
+  std::size_t copy_constructions{0};
+  std::size_t move_constructions{0};
+  std::size_t copy_assignments{0};
+  std::size_t move_assignments{0};
+  std::size_t destructions{0};
+  std::size_t allocations{0};  // 探针对象自身的 operator new 次数
+
+  std::size_t copies() const { return copy_constructions + copy_assignments; }
+  std::size_t moves() const { return move_constructions + move_assignments; }
+  std::size_t constructions() const {
+    return default_constructions + value_constructions + copy_constructions + move_constructions;
+  }
+  // 构造但尚未析构的对象个数
+  std::ptrdiff_t live() const {
+    return static_cast<std::ptrdiff_t>(constructions()) - static_cast<std::ptrdiff_t>(destructions);
+  }
+
+  LifetimeCounts& operator+=(const LifetimeCounts& other) {
+    default_constructions += other.default_constructions;
+    value_constructions += other.value_constructions;
+    copy_constructions += other.copy_constructions;
+    move_constructions += other.move_constructions;
+    copy_assignments += other.copy_assignments;
+    move_assignments += other.move_assignments;
+    destructions += other.destructions;
+    allocations += other.allocations;
+    return *this;
+  }
+  LifetimeCounts operator-(const LifetimeCounts& other) const {
+    return {
+      default_constructions - other.default_constructions,
+      value_constructions - other.value_constructions,
+      copy_constructions - other.copy_constructions,
+      move_constructions - other.move_constructions,
+      copy_assignments - other.copy_assignments,
+      move_assignments - other.move_assignments,
+      destructions - other.destructions,
+      allocations - other.allocations,
+    };
+  }
+  bool operator==(const LifetimeCounts&) const = default;
+};  // struct LifetimeCounts
+
+class LifetimeCounters {
+public:
+  enum Event : std::size_t {
+    kDefaultConstruct,
+    kValueConstruct,
+    kCopyConstruct,
+    kMoveConstruct,
+    kCopyAssign,
+    kMoveAssign,
+    kDestruct,
+    kAllocate,
+    kEventCount,
+  };
+  void add(Event e) {
+    counts_[e].fetch_add(1, std::memory_order_relaxed);
+  }
+  LifetimeCounts snapshot() const {
+    auto load = [this](Event e) { return counts_[e].load(std::memory_order_relaxed); };
+    return {
+      load(kDefaultConstruct), load(kValueConstruct), load(kCopyConstruct), load(kMoveConstruct),
+      load(kCopyAssign), load(kMoveAssign), load(kDestruct), load(kAllocate),
+    };
+  }
+  void reset() {
+    for (auto& c : counts_) {
+      c.store(0, std::memory_order_relaxed);
+    }
+  }
+private:
+  std::array<std::atomic<std::size_t>, kEventCount> counts_{};
+};  // class LifetimeCounters
+
+// 每个 Tag 一组计数器
+template <typename Tag>
+inline LifetimeCounters lifetime_counters{};
+
+// 本线程通过全局 operator new 分配的次数, 只有定义了 UTILS_LIFETIME_PROBE_REPLACE_GLOBAL_NEW 才会增加
+inline thread_local std::size_t t_global_allocations{0};
+
+struct LifetimeReportEntry {
+  std::string site;  // file:line function
+  std::size_t hits{0};  // 该调用点的作用域进入次数
+  LifetimeCounts counts;
+  std::size_t heap_allocations{0};
+};  // struct LifetimeReportEntry
+
+class LifetimeRegistry {
+public:
+  static LifetimeRegistry& instance() {
+    static LifetimeRegistry registry;
+    return registry;
+  }
+  void record(const std::source_location& loc, const LifetimeCounts& counts, std::size_t heap_allocations) {
+    auto site = std::format("{}:{} {}", loc.file_name(), loc.line(), loc.function_name());
+    std::lock_guard lock(mutex_);
+    for (auto& entry : entries_) {
+      if (entry.site == site) {
+        ++entry.hits;
+        entry.counts += counts;
+        entry.heap_allocations += heap_allocations;
+        return;
+      }
+    }
+    entries_.push_back({std::move(site), 1, counts, heap_allocations});
+  }
+  std::vector<LifetimeReportEntry> entries() const {
+    std::lock_guard lock(mutex_);
+    return entries_;
+  }
+  void clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+  }
+private:
+  LifetimeRegistry() = default;
+  mutable std::mutex mutex_;
+  std::vector<LifetimeReportEntry> entries_;
+};  // class LifetimeRegistry
+
+// 统计某个调用点的计数增量, 析构时记录到 LifetimeRegistry
+template <typename Tag>
+class LifetimeScope {
+public:
+  explicit LifetimeScope(std::source_location loc = std::source_location::current())
+      : loc_(loc),
+        start_(lifetime_counters<Tag>.snapshot()),
+        heap_start_(t_global_allocations) {}
+  LifetimeScope(const LifetimeScope&) = delete;
+  LifetimeScope& operator=(const LifetimeScope&) = delete;
+  ~LifetimeScope() {
+    LifetimeRegistry::instance().record(loc_, counts(), heap_allocations());
+  }
+  LifetimeCounts counts() const {
+    return lifetime_counters<Tag>.snapshot() - start_;
+  }
+  std::size_t heap_allocations() const {
+    return t_global_allocations - heap_start_;
+  }
+private:
+  std::source_location loc_;
+  LifetimeCounts start_;
+  std::size_t heap_start_;
+};  // class LifetimeScope
+
+inline std::vector<LifetimeReportEntry> lifetime_report() {
+  return LifetimeRegistry::instance().entries();
+}
+
+inline void print_lifetime_report() {
+  for (const auto& e : lifetime_report()) {
+    const auto& c = e.counts;
+    std::println("{}", e.site);
+    std::println("  hits: {}, default: {}, value: {}, copy: {}, move: {}, copy=: {}, move=: {}, dtor: {}, "
+        "new: {}, global new: {}",
+        e.hits, c.default_constructions, c.value_constructions, c.copy_constructions, c.move_constructions,
+        c.copy_assignments, c.move_assignments, c.destructions, c.allocations, e.heap_allocations);
+  }
+}
+
+// 包装已有类型 T, 所有特殊成员函数都会计数
+// 类类型 T 从 const T& / T&& 构造时分别记为拷贝和移动(也就是 T 的拷贝和移动)
+template <typename T, typename Tag = T>
+class Probed {
+  static_assert(!std::is_reference_v<T>, "Probed<T> requires a non-reference type");
+private:
+  T value_;
+
+  template <typename Arg>
+  static constexpr LifetimeCounters::Event construct_event_of() {
+    // 标量的拷贝没有统计意义, 比如 LifetimeProbe<>{1} 记为 value 构造
+    if constexpr (std::is_class_v<T> && std::is_same_v<std::remove_cvref_t<Arg>, T>) {
+      // Arg 为左值引用或 const 右值时只能拷贝
+      return !std::is_reference_v<Arg> && !std::is_const_v<Arg>
+          ? LifetimeCounters::kMoveConstruct
+          : LifetimeCounters::kCopyConstruct;
+    } else {
+      return LifetimeCounters::kValueConstruct;
+    }
+  }
+  template <typename... Args>
+  static constexpr LifetimeCounters::Event construct_event() {
+    if constexpr (sizeof...(Args) == 1) {
+      return (construct_event_of<Args>(), ...);
+    } else {
+      return LifetimeCounters::kValueConstruct;
+    }
+  }
+public:
+  static LifetimeCounters& counters() { return lifetime_counters<Tag>; }
+
+  Probed() : value_() {
+    counters().add(LifetimeCounters::kDefaultConstruct);
+  }
+  // 不能劫持拷贝/移动构造函数, 参考 chapter_06 Person3
+  template <typename... Args>
+  requires (sizeof...(Args) > 0) &&
+      (sizeof...(Args) != 1 || (!std::is_same_v<std::remove_cvref_t<Args>, Probed> && ...)) &&
+      std::is_constructible_v<T, Args...>
+  Probed(Args&&... args) : value_(std::forward<Args>(args)...) {
+    counters().add(construct_event<Args...>());
+  }
+  Probed(const Probed& other) : value_(other.value_) {
+    counters().add(LifetimeCounters::kCopyConstruct);
+  }
+  Probed(Probed&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : value_(std::move(other.value_)) {
+    counters().add(LifetimeCounters::kMoveConstruct);
+  }
+  Probed& operator=(const Probed& other) {
+    value_ = other.value_;
+    counters().add(LifetimeCounters::kCopyAssign);
+    return *this;
+  }
+  Probed& operator=(Probed&& other) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    value_ = std::move(other.value_);
+    counters().add(LifetimeCounters::kMoveAssign);
+    return *this;
+  }
+  ~Probed() {
+    counters().add(LifetimeCounters::kDestruct);
+  }
+
+  static void* operator new(std::size_t size) {
+    counters().add(LifetimeCounters::kAllocate);
+    return ::operator new(size);
+  }
+  static void operator delete(void* p) noexcept {
+    ::operator delete(p);
+  }
+
+  T& get() & { return value_; }
+  const T& get() const& { return value_; }
+  T&& get() && { return std::move(value_); }
+  T& operator*() { return value_; }
+  const T& operator*() const { return value_; }
+  T* operator->() { return &value_; }
+  const T* operator->() const { return &value_; }
+  operator const T&() const { return value_; }
+
+  friend bool operator==(const Probed& a, const Probed& b) { return a.value_ == b.value_; }
+};  // class Probed
+
+struct LifetimeProbeTag {};
+// 可以直接使用的探针类型
+template <typename Tag = LifetimeProbeTag>
+using LifetimeProbe = Probed<int, Tag>;
+
+}  // namespace utils
+
+template <typename T, typename Tag>
+struct std::formatter<utils::Probed<T, Tag>> : std::formatter<T> {
+  template <typename FormatContext>
+  auto format(const utils::Probed<T, Tag>& p, FormatContext& ctx) const {
+    return std::formatter<T>::format(p.get(), ctx);
+  }
+};
+
+#ifdef UTILS_LIFETIME_PROBE_REPLACE_GLOBAL_NEW
+// 替换全局 operator new, 只能在一个编译单元中定义
+void* operator new(std::size_t size) {
+  ++utils::t_global_allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+#endif  // UTILS_LIFETIME_PROBE_REPLACE_GLOBAL_NEW
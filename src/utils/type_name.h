@@ -0,0 +1,79 @@
+/**
+########################################################################
+#
+# Copyright (c) 2026 xx.com, Inc. All Rights Reserved
+#
+########################################################################
+# Author : xuechengyun
+# E-mail : xuechengyunxue@gmail.com
+# Date   : 2026/10/19 20:41:26
+# Desc   : utils::type_name<T>(): 编译期得到类型名, 不需要 RTTI
+########################################################################
+*/
+/*
+typeid(T).name() 的问题:
+1. 需要 RTTI, -fno-rtti 时无法编译
+2. GCC / Clang 返回的是修饰名(mangled name), 比如 St6vectorIiSaIiEE, 还要用 abi::__cxa_demangle 在运行期解析并分配内存
+3. 会丢掉顶层的 const / volatile 和引用
+type_name<T>() 从 __PRETTY_FUNCTION__(MSVC 为 __FUNCSIG__) 中截取模板实参的部分:
+1. 结果在编译期计算, 保存在一个大小正好的静态数组中, 返回指向它的 std::string_view, 运行期没有任何开销
+2. 保留 cv 限定符和引用: type_name<const int&>() == "const int&"
+3. 不同编译器的拼写不完全相同, 比如 std::string 在 GCC 中为 "std::__cxx11::basic_string<char>", 只适合用于输出
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace utils {
+
+namespace detail {
+
+template <typename T>
+constexpr std::string_view raw_type_name() {
+#if defined(__clang__) || defined(__GNUC__)
+  return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+  return __FUNCSIG__;
+#else
+#error "utils::type_name: unsupported compiler"
+#endif
+}
+
+// 用已知的类型 int 计算函数签名中类型名前后的字符数, 对所有的 T 都相同
+inline constexpr std::string_view kProbeName = "int";
+inline constexpr std::size_t kTypeNamePrefix = raw_type_name<int>().find(kProbeName);
+inline constexpr std::size_t kTypeNameSuffix = raw_type_name<int>().size() - kTypeNamePrefix - kProbeName.size();
+static_assert(kTypeNamePrefix != std::string_view::npos, "utils::type_name: unexpected function signature");
+
+template <typename T>
+constexpr auto type_name_array() {
+  constexpr std::string_view raw = raw_type_name<T>();
+  constexpr std::string_view name = raw.substr(kTypeNamePrefix, raw.size() - kTypeNamePrefix - kTypeNameSuffix);
+  std::array<char, name.size() + 1> result{};  // 以 '\0' 结尾, 可以当作 C 字符串使用
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    result[i] = name[i];
+  }
+  return result;
+}
+
+// 每个类型只保存类型名本身, 而不是整个函数签名
+template <typename T>
+inline constexpr auto type_name_storage = type_name_array<T>();
+
+}  // namespace detail
+
+template <typename T>
+constexpr std::string_view type_name() {
+  constexpr auto& storage = detail::type_name_storage<T>;
+  return {storage.data(), storage.size() - 1};
+}
+
+// 实参的类型(按模板实参推导的规则, 不保留顶层 cv 和引用)
+template <typename T>
+constexpr std::string_view type_name_of(const T&) {
+  return type_name<T>();
+}
+
+}  // namespace utils